@@ -1,7 +1,20 @@
 #include "data/fs.h"
+#include <SDL3/SDL.h>
 #include <stdio.h>
 #include <stdlib.h>
 
+#if defined(__EMSCRIPTEN__)
+#include <emscripten.h>
+#elif defined(_WIN32)
+#define WIN32_LEAN_AND_MEAN
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
 bool fs_read_file(const char *path, char **out, long *size) {
     FILE *f = fopen(path, "rb");
     if (!f) return false;
@@ -37,3 +50,114 @@ bool fs_read_file(const char *path, char **out, long *size) {
     if (size) *size = len;
     return true;
 }
+
+#if defined(__EMSCRIPTEN__)
+// Synchronous ranged GET. Binary bodies come back through the
+// x-user-defined charset, which maps each byte to one UTF-16 unit.
+// Servers that ignore Range answer 200 with the whole file; slice that.
+EM_JS(int, fetch_range, (const char *url, double offset, int size, void *dst), {
+    var xhr = new XMLHttpRequest();
+    xhr.open('GET', UTF8ToString(url), false);
+    xhr.overrideMimeType('text/plain; charset=x-user-defined');
+    xhr.setRequestHeader('Range', 'bytes=' + offset + '-' + (offset + size - 1));
+    try { xhr.send(null); } catch (e) { return 0; }
+    var body = xhr.responseText;
+    var start = 0;
+    if (xhr.status == 200) start = offset;
+    else if (xhr.status != 206) return 0;
+    if (body.length < start + size) return 0;
+    for (var i = 0; i < size; i++) HEAPU8[dst + i] = body.charCodeAt(start + i) & 0xff;
+    return 1;
+});
+
+// Same request through fetch(); completes from the browser's event loop
+EM_JS(void, fetch_range_async, (const char *url, double offset, int size, void *dst, volatile s32 *status), {
+    fetch(UTF8ToString(url), { headers: { 'Range': 'bytes=' + offset + '-' + (offset + size - 1) } })
+        .then(function(res) {
+            if (res.status != 200 && res.status != 206) throw 0;
+            var start = res.status == 200 ? offset : 0;
+            return res.arrayBuffer().then(function(buf) {
+                if (buf.byteLength < start + size) throw 0;
+                HEAPU8.set(new Uint8Array(buf, start, size), dst);
+                HEAP32[status >> 2] = 1;
+            });
+        })
+        .catch(function() { HEAP32[status >> 2] = 2; });
+});
+#endif
+
+bool fs_read_range(const char *path, u64 offset, size_t size, void *dst) {
+    if (size == 0) return true;
+#if defined(__EMSCRIPTEN__)
+    return fetch_range(path, (double)offset, (int)size, dst) != 0;
+#else
+    SDL_IOStream *io = SDL_IOFromFile(path, "rb");
+    if (!io) return false;
+    bool ok = SDL_SeekIO(io, (Sint64)offset, SDL_IO_SEEK_SET) == (Sint64)offset
+           && SDL_ReadIO(io, dst, size) == size;
+    SDL_CloseIO(io);
+    return ok;
+#endif
+}
+
+void fs_read_range_async(const char *path, u64 offset, size_t size, void *dst,
+                         volatile s32 *status) {
+    *status = FS_READ_PENDING;
+#if defined(__EMSCRIPTEN__)
+    if (size > 0) {
+        fetch_range_async(path, (double)offset, (int)size, dst, status);
+        return;
+    }
+#endif
+    *status = fs_read_range(path, offset, size, dst) ? FS_READ_DONE : FS_READ_FAILED;
+}
+
+void *fs_map_file(const char *path, size_t *size) {
+    *size = 0;
+#if defined(__EMSCRIPTEN__)
+    return SDL_LoadFile(path, size);
+#elif defined(_WIN32)
+    HANDLE file = CreateFileA(path, GENERIC_READ, FILE_SHARE_READ | FILE_SHARE_DELETE,
+                              NULL, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL);
+    if (file == INVALID_HANDLE_VALUE) return NULL;
+
+    void *base = NULL;
+    LARGE_INTEGER len;
+    if (GetFileSizeEx(file, &len) && len.QuadPart > 0) {
+        HANDLE mapping = CreateFileMappingA(file, NULL, PAGE_READONLY, 0, 0, NULL);
+        if (mapping) {
+            base = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+            CloseHandle(mapping);
+        }
+        *size = (size_t)len.QuadPart;
+    }
+    CloseHandle(file);
+    return base;
+#else
+    int fd = open(path, O_RDONLY);
+    if (fd < 0) return NULL;
+
+    void *base = NULL;
+    struct stat st;
+    if (fstat(fd, &st) == 0 && st.st_size > 0) {
+        base = mmap(NULL, (size_t)st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+        if (base == MAP_FAILED) base = NULL;
+        *size = (size_t)st.st_size;
+    }
+    close(fd);
+    return base;
+#endif
+}
+
+void fs_unmap_file(void *base, size_t size) {
+    if (!base) return;
+#if defined(__EMSCRIPTEN__)
+    (void)size;
+    SDL_free(base);
+#elif defined(_WIN32)
+    (void)size;
+    UnmapViewOfFile(base);
+#else
+    munmap(base, size);
+#endif
+}
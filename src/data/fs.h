@@ -1,4 +1,26 @@
 #pragma once
 #include <stdbool.h>
+#include <stddef.h>
+#include "utils/q_util.h"
 
 bool fs_read_file(const char *path, char **out, long *size);
+
+// Read exactly `size` bytes at `offset` into `dst`. The web build issues an
+// HTTP range request for `path` relative to the page instead of reading the
+// preloaded filesystem, so large archives need not be downloaded up front.
+bool fs_read_range(const char *path, u64 offset, size_t size, void *dst);
+
+// fs_read_range without waiting: `*status` stays FS_READ_PENDING until the
+// bytes are in `dst`, then becomes FS_READ_DONE or FS_READ_FAILED. The web
+// build sends a fetch() and the browser writes the result when it lands, so
+// `dst` and `status` must outlive the request. Natively this reads at once.
+#define FS_READ_PENDING 0
+#define FS_READ_DONE    1
+#define FS_READ_FAILED  2
+void fs_read_range_async(const char *path, u64 offset, size_t size, void *dst,
+                         volatile s32 *status);
+
+// Map `path` read-only; returns the base pointer (NULL on failure or for an
+// empty file) and its size. The web build has no mmap and reads a heap copy.
+void *fs_map_file(const char *path, size_t *size);
+void fs_unmap_file(void *base, size_t size);
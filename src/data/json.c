@@ -1,148 +1,370 @@
 #include "data/json.h"
+#include "data/json_pull.h"
 #include "data/fs.h"
 #include <SDL3/SDL.h>
-#include <cJSON.h>
+#include <float.h>
+#include <stddef.h>
 #include <stdlib.h>
+#include <string.h>
 
-static bool parse_vec2(const cJSON *arr, Vec2 *v) {
-    if (!cJSON_IsArray(arr) || cJSON_GetArraySize(arr) < 2) return false;
-    v->x = (f32)cJSON_GetArrayItem(arr, 0)->valuedouble;
-    v->y = (f32)cJSON_GetArrayItem(arr, 1)->valuedouble;
-    return true;
+// ---------------------------------------------------------------------------
+// Schema
+//
+// One table describes the JSON level format: the key, where the value
+// lives in LevelDesc, and the range it is clamped to. The reader and the
+// writer below both walk it, so a field added here is loaded and saved.
+// ---------------------------------------------------------------------------
+
+typedef enum {
+    FIELD_F32,
+    FIELD_S32,
+    FIELD_U32,
+    FIELD_VEC2,
+    FIELD_STRING,   // arg = buffer size
+    FIELD_FLAG,     // bool stored as bit `arg` of a u32
+    FIELD_OBJECT,   // nested keys, same record
+    FIELD_ARRAY,    // records of `sub`; arg = offset of the s32 count
+} FieldType;
+
+typedef struct Schema Schema;
+
+typedef struct {
+    const char   *key;
+    FieldType     type;
+    u32           offset;   // into the record
+    u32           arg;
+    double        min, max; // numbers are clamped; arrays hold at most `max`
+    const Schema *sub;
+} Field;
+
+struct Schema {
+    const Field *fields;
+    s32          count;
+    u32          size;      // record size, the stride of an array
+    // Fill derived values; bit i of `seen` is set when fields[i] was present
+    void (*finish)(void *record, s32 index, u32 seen);
+};
+
+#define D(f) (u32)offsetof(LevelDesc, f)
+#define P(f) (u32)offsetof(LevelPlanet, f)
+
+#define F32(k, off, lo, hi)  { k, FIELD_F32,  off, 0, lo, hi, NULL }
+#define S32(k, off, lo, hi)  { k, FIELD_S32,  off, 0, lo, hi, NULL }
+#define U32(k, off)          { k, FIELD_U32,  off, 0, 0, (double)UINT32_MAX, NULL }
+#define VEC2(k, off)         { k, FIELD_VEC2, off, 0, -FLT_MAX, FLT_MAX, NULL }
+#define FLAG(k, off, bit)    { k, FIELD_FLAG, off, bit, 0, 0, NULL }
+#define OBJECT(k, schema)    { k, FIELD_OBJECT, 0, 0, 0, 0, &schema }
+#define ARRAY(k, off, count, n, schema) { k, FIELD_ARRAY, off, count, 0, n, &schema }
+#define SCHEMA(fields, type, finish) { fields, SDL_arraysize(fields), sizeof(type), finish }
+
+enum { PLANET_POS, PLANET_RADIUS, PLANET_MU, PLANET_EPS, PLANET_SEED, PLANET_TYPE };
+
+static const Field planet_fields[] = {
+    [PLANET_POS]    = VEC2("pos",    P(pos)),
+    [PLANET_RADIUS] = F32 ("radius", P(radius), 0.0, 1e4),
+    [PLANET_MU]     = F32 ("mu",     P(mu),    -1e6, 1e6),   // negative repels
+    [PLANET_EPS]    = F32 ("eps",    P(eps),    0.0, 1e4),
+    [PLANET_SEED]   = U32 ("seed",   P(seed)),
+    [PLANET_TYPE]   = U32 ("type",   P(type)),
+};
+
+// Seed and type are optional: derive them from the position
+static void planet_finish(void *record, s32 index, u32 seen) {
+    LevelPlanet *p = record;
+    if (!(seen & (1u << PLANET_SEED)))
+        p->seed = level_planet_seed(p->pos, index);
+    if (seen & (1u << PLANET_TYPE))
+        p->type %= PLANET_TYPE_COUNT;
+    else
+        p->type = p->seed % PLANET_TYPE_COUNT;
 }
 
-bool json_load(const char *path, Game *game) {
-    char *buf = NULL;
-    long size = 0;
-    if (!fs_read_file(path, &buf, &size)) {
-        SDL_Log("json_load: failed to read file '%s'", path);
-        return false;
-    }
+static const Field bounds_fields[] = {
+    VEC2("min", D(bounds_min)),
+    VEC2("max", D(bounds_max)),
+};
 
-    cJSON *root = cJSON_Parse(buf);
-    if (!root) {
-        SDL_Log("json_load: parse error in '%s': %s", path, cJSON_GetErrorPtr());
-        free(buf);
-        return false;
-    }
+static const Field start_fields[] = {
+    VEC2("pos",     D(start_pos)),
+    F32 ("vel_max", D(vel_max), 0.0, 1e4),
+};
 
-    // ppm
-    cJSON *ppm = cJSON_GetObjectItem(root, "ppm");
-    if (cJSON_IsNumber(ppm))
-        game->cam.ppm = (f32)ppm->valuedouble;
-
-    // bounds
-    cJSON *bounds = cJSON_GetObjectItem(root, "bounds");
-    if (bounds) {
-        cJSON *bmin = cJSON_GetObjectItem(bounds, "min");
-        cJSON *bmax = cJSON_GetObjectItem(bounds, "max");
-        if (bmin) parse_vec2(bmin, &game->bounds_min);
-        if (bmax) parse_vec2(bmax, &game->bounds_max);
-    }
+static const Field goal_fields[] = {
+    VEC2("pos",    D(goal_pos)),
+    F32 ("radius", D(goal_radius), 0.0, 1e4),
+};
 
-    // start
-    cJSON *start = cJSON_GetObjectItem(root, "start");
-    if (start) {
-        cJSON *pos = cJSON_GetObjectItem(start, "pos");
-        if (pos) parse_vec2(pos, &game->ships[0].pos);
+static const Field ship_fields[] = {
+    F32("radius",      D(ship_radius),      0.01, 100.0),
+    F32("density",     D(ship_density),     1e-3, 1e4),
+    F32("restitution", D(ship_restitution), 0.0,  1.0),
+};
 
-        cJSON *vel_max = cJSON_GetObjectItem(start, "vel_max");
-        if (cJSON_IsNumber(vel_max))
-            game->vel_max = (f32)vel_max->valuedouble;
-    }
+static const Field allow_fields[] = {
+    FLAG("sink",  D(flags), LEVEL_FLAG_ALLOW_SINK),
+    FLAG("repel", D(flags), LEVEL_FLAG_ALLOW_REPEL),
+    S32 ("max",   D(allow_max), 0, 10),
+};
+
+static const Field fleet_fields[] = {
+    S32("count",    D(fleet_count),    1, MAX_FLEET),
+    S32("required", D(fleet_required), 1, MAX_FLEET),
+};
+
+static const Field ui_fields[] = {
+    FLAG("show_field_default", D(flags), LEVEL_FLAG_SHOW_FIELD),
+};
+
+static const Schema planet_schema = SCHEMA(planet_fields, LevelPlanet, planet_finish);
+static const Schema bounds_schema = SCHEMA(bounds_fields, LevelDesc, NULL);
+static const Schema start_schema  = SCHEMA(start_fields,  LevelDesc, NULL);
+static const Schema goal_schema   = SCHEMA(goal_fields,   LevelDesc, NULL);
+static const Schema ship_schema   = SCHEMA(ship_fields,   LevelDesc, NULL);
+static const Schema allow_schema  = SCHEMA(allow_fields,  LevelDesc, NULL);
+static const Schema fleet_schema  = SCHEMA(fleet_fields,  LevelDesc, NULL);
+static const Schema ui_schema     = SCHEMA(ui_fields,     LevelDesc, NULL);
+
+// Also the order keys are written in
+static const Field level_fields[] = {
+    { "name", FIELD_STRING, D(name), LEVEL_NAME_MAX, 0, 0, NULL },
+    F32   ("ppm",         D(ppm),        1.0, 1000.0),
+    S32   ("difficulty",  D(difficulty), 1, 10),
+    OBJECT("bounds",      bounds_schema),
+    OBJECT("start",       start_schema),
+    OBJECT("goal",        goal_schema),
+    OBJECT("ship",        ship_schema),
+    ARRAY ("planets",     D(planets), D(planet_count), MAX_PLANETS, planet_schema),
+    OBJECT("allow_place", allow_schema),
+    OBJECT("fleet",       fleet_schema),
+    OBJECT("ui",          ui_schema),
+};
+
+static const Schema level_schema = SCHEMA(level_fields, LevelDesc, NULL);
+
+SDL_COMPILE_TIME_ASSERT(planet_fields_fit, SDL_arraysize(planet_fields) <= 32);
 
-    // ship
-    cJSON *ship = cJSON_GetObjectItem(root, "ship");
-    if (ship) {
-        cJSON *radius = cJSON_GetObjectItem(ship, "radius");
-        if (cJSON_IsNumber(radius))
-            game->ships[0].radius = (f32)radius->valuedouble;
+// ---------------------------------------------------------------------------
+// Load
+// ---------------------------------------------------------------------------
+
+static bool read_object(JsonReader *r, const Schema *s, u8 *rec, u32 *seen);
+
+static bool read_clamped(JsonReader *r, const Field *f, double *v) {
+    if (!json_read_number(r, v)) return false;
+    if (*v < f->min || *v > f->max) {
+        json_warn(r, "'%s' = %g is outside [%g, %g], clamped", f->key, *v, f->min, f->max);
+        *v = CLAMP(*v, f->min, f->max);
     }
+    return true;
+}
 
-    // goal
-    cJSON *goal = cJSON_GetObjectItem(root, "goal");
-    if (goal) {
-        cJSON *pos = cJSON_GetObjectItem(goal, "pos");
-        if (pos) parse_vec2(pos, &game->goal.pos);
+static bool read_array(JsonReader *r, const Field *f, u8 *rec) {
+    const Schema *sub = f->sub;
+    s32 max = (s32)f->max;
+    s32 n = 0;
 
-        cJSON *radius = cJSON_GetObjectItem(goal, "radius");
-        if (cJSON_IsNumber(radius))
-            game->goal.radius = (f32)radius->valuedouble;
+    if (!json_begin_array(r)) return false;
+    while (json_next_element(r)) {
+        if (n >= max) {
+            json_mark(r);
+            if (n == max) json_warn(r, "more than %d '%s', the rest are ignored", max, f->key);
+            n++;
+            if (!json_skip_value(r)) return false;
+            continue;
+        }
+        u8 *elem = rec + f->offset + (size_t)n * sub->size;
+        u32 seen = 0;
+        if (!read_object(r, sub, elem, &seen)) return false;
+        if (sub->finish) sub->finish(elem, n, seen);
+        n++;
     }
+    *(s32 *)(rec + f->arg) = MIN(n, max);
+    return !r->failed;
+}
 
-    // planets
-    cJSON *planets = cJSON_GetObjectItem(root, "planets");
-    if (cJSON_IsArray(planets)) {
-        int count = cJSON_GetArraySize(planets);
-        if (count > MAX_PLANETS) count = MAX_PLANETS;
-        game->planet_count = count;
-
-        for (int i = 0; i < count; i++) {
-            cJSON *p = cJSON_GetArrayItem(planets, i);
-            Planet *planet = &game->planets[i];
-
-            cJSON *pos = cJSON_GetObjectItem(p, "pos");
-            if (pos) parse_vec2(pos, &planet->pos);
-
-            cJSON *radius = cJSON_GetObjectItem(p, "radius");
-            if (cJSON_IsNumber(radius))
-                planet->radius = (f32)radius->valuedouble;
-
-            cJSON *mu = cJSON_GetObjectItem(p, "mu");
-            if (cJSON_IsNumber(mu))
-                planet->mu = (f32)mu->valuedouble;
-
-            cJSON *eps = cJSON_GetObjectItem(p, "eps");
-            if (cJSON_IsNumber(eps))
-                planet->eps = (f32)eps->valuedouble;
-
-            // Optional visual fields
-            cJSON *seed_j = cJSON_GetObjectItem(p, "seed");
-            if (cJSON_IsNumber(seed_j)) {
-                planet->seed = (u32)seed_j->valuedouble;
-            } else {
-                // Deterministic seed from position
-                u32 hx = *(u32 *)&planet->pos.x;
-                u32 hy = *(u32 *)&planet->pos.y;
-                planet->seed = hx * 2654435761u ^ hy * 2246822519u ^ (u32)i;
-            }
+static bool read_field(JsonReader *r, const Field *f, u8 *rec) {
+    void *dst = rec + f->offset;
+    double v;
+
+    switch (f->type) {
+    case FIELD_F32:
+        if (!read_clamped(r, f, &v)) return false;
+        *(f32 *)dst = (f32)v;
+        return true;
+    case FIELD_S32:
+        if (!read_clamped(r, f, &v)) return false;
+        *(s32 *)dst = (s32)v;
+        return true;
+    case FIELD_U32:
+        if (!read_clamped(r, f, &v)) return false;
+        *(u32 *)dst = (u32)v;
+        return true;
+    case FIELD_VEC2: {
+        Vec2 *out = dst;
+        f32 xy[2];
+        s32 n = 0;
+        if (!json_begin_array(r)) return false;
+        while (json_next_element(r)) {
+            if (!json_read_number(r, &v)) return false;
+            if (n < 2) xy[n] = (f32)v;
+            n++;
+        }
+        if (r->failed) return false;
+        if (n != 2) {
+            json_warn(r, "'%s' needs [x, y], ignored", f->key);
+            return true;
+        }
+        out->x = xy[0];
+        out->y = xy[1];
+        return true;
+    }
+    case FIELD_STRING: {
+        bool truncated = false;
+        if (!json_read_string(r, dst, f->arg, &truncated)) return false;
+        if (truncated) json_warn(r, "'%s' is longer than %u bytes, cut short", f->key, f->arg - 1);
+        return true;
+    }
+    case FIELD_FLAG: {
+        bool b;
+        if (!json_read_bool(r, &b)) return false;
+        if (b) *(u32 *)dst |= f->arg;
+        else   *(u32 *)dst &= ~f->arg;
+        return true;
+    }
+    case FIELD_OBJECT: {
+        u32 seen = 0;
+        return read_object(r, f->sub, rec, &seen);
+    }
+    case FIELD_ARRAY:
+        return read_array(r, f, rec);
+    }
+    return false;
+}
 
-            cJSON *type_j = cJSON_GetObjectItem(p, "type");
-            if (cJSON_IsNumber(type_j)) {
-                planet->type = (PlanetType)((int)type_j->valuedouble % PLANET_TYPE_COUNT);
-            } else {
-                planet->type = (PlanetType)(planet->seed % PLANET_TYPE_COUNT);
+static bool read_object(JsonReader *r, const Schema *s, u8 *rec, u32 *seen) {
+    char key[32];
+    if (!json_begin_object(r)) return false;
+    while (json_next_key(r, key, sizeof(key))) {
+        const Field *f = NULL;
+        for (s32 i = 0; i < s->count; i++) {
+            if (strcmp(s->fields[i].key, key) == 0) {
+                f = &s->fields[i];
+                *seen |= 1u << (i & 31);
+                break;
             }
+        }
 
-            // Rotation speed varies by type
-            f32 base_speeds[] = { 2.0f, 3.0f, 8.0f, 1.5f, 5.0f };
-            planet->rotation_speed = base_speeds[planet->type];
-            planet->rotation_angle = 0.0f;
-            planet->texture = NULL;
+        if (!f) {
+            json_mark(r);
+            if (key[0]) json_warn(r, "unknown key '%s' ignored", key);
+            if (!json_skip_value(r)) return false;
+        } else if (json_peek(r) == JSON_NULL) {
+            // null reads as absent
+            if (!json_skip_value(r)) return false;
+        } else if (!read_field(r, f, rec)) {
+            return false;
         }
     }
+    return !r->failed;
+}
 
-    // fleet config
-    cJSON *fleet = cJSON_GetObjectItem(root, "fleet");
-    if (fleet) {
-        cJSON *count = cJSON_GetObjectItem(fleet, "count");
-        if (cJSON_IsNumber(count))
-            game->fleet_count = (s32)count->valuedouble;
+bool json_parse_desc(const char *name, const char *text, size_t size, LevelDesc *desc) {
+    level_desc_defaults(desc);
 
-        cJSON *required = cJSON_GetObjectItem(fleet, "required");
-        if (cJSON_IsNumber(required))
-            game->required_ships = (s32)required->valuedouble;
+    JsonReader r;
+    json_reader_init(&r, name, text, size);
+    u32 seen = 0;
+    if (!read_object(&r, &level_schema, (u8 *)desc, &seen) || !json_end(&r)) {
+        SDL_Log("%s", r.error);
+        return false;
     }
+    return true;
+}
 
-    // ui
-    cJSON *ui = cJSON_GetObjectItem(root, "ui");
-    if (ui) {
-        cJSON *show_field = cJSON_GetObjectItem(ui, "show_field_default");
-        if (cJSON_IsBool(show_field))
-            game->show_field = cJSON_IsTrue(show_field);
+bool json_load_desc(const char *path, LevelDesc *desc) {
+    char *buf = NULL;
+    long size = 0;
+    if (!fs_read_file(path, &buf, &size)) {
+        SDL_Log("json_load: failed to read file '%s'", path);
+        return false;
     }
 
-    cJSON_Delete(root);
+    bool ok = json_parse_desc(path, buf, (size_t)size, desc);
     free(buf);
+    return ok;
+}
+
+bool json_load(const char *path, Game *game) {
+    LevelDesc desc;
+    if (!json_load_desc(path, &desc))
+        return false;
+    level_desc_apply(&desc, game);
     return true;
 }
+
+// ---------------------------------------------------------------------------
+// Save
+// ---------------------------------------------------------------------------
+
+static void write_object(JsonWriter *w, const Schema *s, const u8 *rec) {
+    json_begin_write_object(w);
+    for (s32 i = 0; i < s->count; i++) {
+        const Field *f = &s->fields[i];
+        const void *src = rec + f->offset;
+        json_write_key(w, f->key);
+
+        switch (f->type) {
+        case FIELD_F32:
+            json_write_f32(w, *(const f32 *)src);
+            break;
+        case FIELD_S32:
+            json_write_int(w, *(const s32 *)src);
+            break;
+        case FIELD_U32:
+            json_write_int(w, *(const u32 *)src);
+            break;
+        case FIELD_VEC2: {
+            const Vec2 *v = src;
+            json_begin_write_array(w, true);
+            json_write_f32(w, v->x);
+            json_write_f32(w, v->y);
+            json_end_write_array(w);
+            break;
+        }
+        case FIELD_STRING:
+            json_write_string(w, src);
+            break;
+        case FIELD_FLAG:
+            json_write_bool(w, (*(const u32 *)src & f->arg) != 0);
+            break;
+        case FIELD_OBJECT:
+            write_object(w, f->sub, rec);
+            break;
+        case FIELD_ARRAY: {
+            s32 n = CLAMP(*(const s32 *)(rec + f->arg), 0, (s32)f->max);
+            json_begin_write_array(w, false);
+            for (s32 k = 0; k < n; k++)
+                write_object(w, f->sub, (const u8 *)src + (size_t)k * f->sub->size);
+            json_end_write_array(w);
+            break;
+        }
+        }
+    }
+    json_end_write_object(w);
+}
+
+bool json_save_desc(const char *path, const LevelDesc *desc) {
+    SDL_IOStream *io = SDL_IOFromFile(path, "wb");
+    if (!io) {
+        SDL_Log("json_save: failed to open '%s': %s", path, SDL_GetError());
+        return false;
+    }
+
+    JsonWriter w;
+    json_writer_init(&w, io);
+    write_object(&w, &level_schema, (const u8 *)desc);
+    bool ok = json_writer_finish(&w);
+    ok = SDL_CloseIO(io) && ok;
+    if (!ok) SDL_Log("json_save: failed to write '%s'", path);
+    return ok;
+}
@@ -1,5 +1,17 @@
 #pragma once
 #include <stdbool.h>
+#include <stddef.h>
 #include "game/game.h"
+#include "data/level.h"
 
+// JSON levels, read and written through one schema table (json.c) with the
+// allocation-free pull reader/writer in data/json_pull.h. Out-of-range
+// values are clamped with a warning; malformed input fails with the line
+// and column of the problem.
+
+// Parse a JSON level into `desc` (defaults for anything left out). `text`
+// must be NUL-terminated; `name` is used in messages.
+bool json_parse_desc(const char *name, const char *text, size_t size, LevelDesc *desc);
+bool json_load_desc(const char *path, LevelDesc *desc);
 bool json_load(const char *path, Game *game);
+bool json_save_desc(const char *path, const LevelDesc *desc);
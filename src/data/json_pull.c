@@ -0,0 +1,553 @@
+#include "data/json_pull.h"
+#include <math.h>
+#include <stdarg.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define MAX_DEPTH 64
+
+// ---------------------------------------------------------------------------
+// Reader
+// ---------------------------------------------------------------------------
+
+void json_reader_init(JsonReader *r, const char *path, const char *text, size_t size) {
+    memset(r, 0, sizeof(*r));
+    r->path       = path;
+    r->cur        = text;
+    r->end        = text + size;
+    r->line_start = text;
+    r->line       = 1;
+}
+
+static s32 column(const JsonReader *r, const char *at) {
+    return (s32)(at - r->line_start) + 1;
+}
+
+void json_error(JsonReader *r, const char *fmt, ...) {
+    if (r->failed) return;
+    r->failed = true;
+
+    char msg[192];
+    va_list ap;
+    va_start(ap, fmt);
+    vsnprintf(msg, sizeof(msg), fmt, ap);
+    va_end(ap);
+    snprintf(r->error, sizeof(r->error), "%s:%d:%d: %s",
+             r->path, r->line, column(r, r->cur), msg);
+}
+
+void json_warn(const JsonReader *r, const char *fmt, ...) {
+    char msg[192];
+    va_list ap;
+    va_start(ap, fmt);
+    vsnprintf(msg, sizeof(msg), fmt, ap);
+    va_end(ap);
+    SDL_Log("%s:%d:%d: %s", r->path, r->line, column(r, r->tok ? r->tok : r->cur), msg);
+}
+
+static void skip_ws(JsonReader *r) {
+    while (r->cur < r->end) {
+        char c = *r->cur;
+        if (c == '\n') {
+            r->line++;
+            r->line_start = r->cur + 1;
+        } else if (c != ' ' && c != '\t' && c != '\r') {
+            return;
+        }
+        r->cur++;
+    }
+}
+
+static char peek_char(JsonReader *r) {
+    skip_ws(r);
+    return r->cur < r->end ? *r->cur : '\0';
+}
+
+static bool expect(JsonReader *r, char c, const char *what) {
+    if (peek_char(r) != c) {
+        json_error(r, "expected %s", what);
+        return false;
+    }
+    r->cur++;
+    return true;
+}
+
+JsonType json_peek(JsonReader *r) {
+    if (r->failed) return JSON_NONE;
+    switch (peek_char(r)) {
+    case '{': return JSON_OBJECT;
+    case '[': return JSON_ARRAY;
+    case '"': return JSON_STRING;
+    case 't': case 'f': return JSON_BOOL;
+    case 'n': return JSON_NULL;
+    case '-': case '0': case '1': case '2': case '3': case '4':
+    case '5': case '6': case '7': case '8': case '9':
+        return JSON_NUMBER;
+    default: return JSON_NONE;
+    }
+}
+
+static const char *type_name(JsonType t) {
+    static const char *names[] = {
+        "end of input", "object", "array", "string", "number", "true/false", "null",
+    };
+    return names[t];
+}
+
+// Start of a value: check its type and remember where it began
+static bool begin_value(JsonReader *r, JsonType want) {
+    JsonType got = json_peek(r);
+    if (r->failed) return false;
+    if (got != want) {
+        if (got == JSON_NONE && r->cur < r->end)
+            json_error(r, "unexpected character '%c'", *r->cur);
+        else
+            json_error(r, "expected %s, found %s", type_name(want), type_name(got));
+        return false;
+    }
+    r->tok = r->cur;
+    return true;
+}
+
+bool json_begin_object(JsonReader *r) {
+    if (!begin_value(r, JSON_OBJECT)) return false;
+    if (++r->depth > MAX_DEPTH) {
+        json_error(r, "nested too deeply");
+        return false;
+    }
+    r->cur++;
+    r->need_comma = false;
+    return true;
+}
+
+bool json_begin_array(JsonReader *r) {
+    if (!begin_value(r, JSON_ARRAY)) return false;
+    if (++r->depth > MAX_DEPTH) {
+        json_error(r, "nested too deeply");
+        return false;
+    }
+    r->cur++;
+    r->need_comma = false;
+    return true;
+}
+
+// Shared by keys and elements: false at `close`, else positioned on the
+// next item
+static bool next_item(JsonReader *r, char close) {
+    if (r->failed) return false;
+    char c = peek_char(r);
+    if (c == close) {
+        r->cur++;
+        r->depth--;
+        r->need_comma = true;   // the container was a value of its parent
+        return false;
+    }
+    if (r->need_comma) {
+        if (c != ',') {
+            json_error(r, "expected ',' or '%c'", close);
+            return false;
+        }
+        r->cur++;
+        if (peek_char(r) == close) {
+            json_error(r, "trailing comma");
+            return false;
+        }
+    }
+    r->need_comma = false;
+    return true;
+}
+
+bool json_next_key(JsonReader *r, char *key, size_t cap) {
+    if (!next_item(r, '}')) return false;
+    if (peek_char(r) != '"') {
+        json_error(r, "expected a key string");
+        return false;
+    }
+    bool truncated = false;
+    if (!json_read_string(r, key, cap, &truncated)) return false;
+    if (truncated) {
+        json_warn(r, "key too long");
+        key[0] = '\0';   // matches nothing, so the value is skipped
+    }
+    if (!expect(r, ':', "':' after key")) return false;
+    r->need_comma = false;
+    return true;
+}
+
+bool json_next_element(JsonReader *r) {
+    return next_item(r, ']');
+}
+
+bool json_read_number(JsonReader *r, double *out) {
+    if (!begin_value(r, JSON_NUMBER)) return false;
+
+    // Validate the JSON grammar; strtod alone accepts more (hex, inf, ...)
+    const char *p = r->cur;
+    if (*p == '-') p++;
+    if (*p == '0') {
+        p++;
+    } else if (*p >= '1' && *p <= '9') {
+        while (*p >= '0' && *p <= '9') p++;
+    } else {
+        json_error(r, "malformed number");
+        return false;
+    }
+    if (*p == '.') {
+        p++;
+        if (!(*p >= '0' && *p <= '9')) {
+            r->cur = p;
+            json_error(r, "expected digits after '.'");
+            return false;
+        }
+        while (*p >= '0' && *p <= '9') p++;
+    }
+    if (*p == 'e' || *p == 'E') {
+        p++;
+        if (*p == '+' || *p == '-') p++;
+        if (!(*p >= '0' && *p <= '9')) {
+            r->cur = p;
+            json_error(r, "expected exponent digits");
+            return false;
+        }
+        while (*p >= '0' && *p <= '9') p++;
+    }
+
+    *out = strtod(r->cur, NULL);
+    r->cur = p;
+    r->need_comma = true;
+    return true;
+}
+
+static bool match_literal(JsonReader *r, const char *lit) {
+    size_t n = strlen(lit);
+    if ((size_t)(r->end - r->cur) < n || memcmp(r->cur, lit, n) != 0) {
+        json_error(r, "unknown literal (expected %s)", lit);
+        return false;
+    }
+    r->cur += n;
+    r->need_comma = true;
+    return true;
+}
+
+bool json_read_bool(JsonReader *r, bool *out) {
+    if (!begin_value(r, JSON_BOOL)) return false;
+    *out = *r->cur == 't';
+    return match_literal(r, *out ? "true" : "false");
+}
+
+static s32 hex4(const char *p) {
+    s32 v = 0;
+    for (s32 i = 0; i < 4; i++) {
+        char c = p[i];
+        v <<= 4;
+        if (c >= '0' && c <= '9')      v |= c - '0';
+        else if (c >= 'a' && c <= 'f') v |= c - 'a' + 10;
+        else if (c >= 'A' && c <= 'F') v |= c - 'A' + 10;
+        else return -1;
+    }
+    return v;
+}
+
+// Append `cp` as UTF-8 if it fits whole
+static void put_codepoint(char *out, size_t cap, size_t *len, u32 cp, bool *truncated) {
+    char tmp[4];
+    size_t n;
+    if (cp < 0x80) {
+        tmp[0] = (char)cp;
+        n = 1;
+    } else if (cp < 0x800) {
+        tmp[0] = (char)(0xC0 | (cp >> 6));
+        tmp[1] = (char)(0x80 | (cp & 0x3F));
+        n = 2;
+    } else if (cp < 0x10000) {
+        tmp[0] = (char)(0xE0 | (cp >> 12));
+        tmp[1] = (char)(0x80 | ((cp >> 6) & 0x3F));
+        tmp[2] = (char)(0x80 | (cp & 0x3F));
+        n = 3;
+    } else {
+        tmp[0] = (char)(0xF0 | (cp >> 18));
+        tmp[1] = (char)(0x80 | ((cp >> 12) & 0x3F));
+        tmp[2] = (char)(0x80 | ((cp >> 6) & 0x3F));
+        tmp[3] = (char)(0x80 | (cp & 0x3F));
+        n = 4;
+    }
+    if (!out) return;
+    if (*len + n >= cap) {
+        *truncated = true;
+        return;
+    }
+    memcpy(out + *len, tmp, n);
+    *len += n;
+}
+
+bool json_read_string(JsonReader *r, char *out, size_t cap, bool *truncated) {
+    if (!begin_value(r, JSON_STRING)) return false;
+    r->cur++;
+
+    size_t len = 0;
+    bool cut = false;
+    while (true) {
+        if (r->cur >= r->end) {
+            json_error(r, "unterminated string");
+            return false;
+        }
+        u8 c = (u8)*r->cur;
+        if (c == '"') {
+            r->cur++;
+            break;
+        }
+        if (c < 0x20) {
+            json_error(r, "control character in string");
+            return false;
+        }
+        if (c != '\\') {
+            // Raw bytes, UTF-8 included, are copied as they are
+            if (out && !cut) {
+                if (len + 1 < cap) out[len++] = (char)c;
+                else cut = true;
+            }
+            r->cur++;
+            continue;
+        }
+
+        r->cur++;
+        char e = r->cur < r->end ? *r->cur : '\0';
+        u32 cp;
+        switch (e) {
+        case '"':  cp = '"';  break;
+        case '\\': cp = '\\'; break;
+        case '/':  cp = '/';  break;
+        case 'b':  cp = '\b'; break;
+        case 'f':  cp = '\f'; break;
+        case 'n':  cp = '\n'; break;
+        case 'r':  cp = '\r'; break;
+        case 't':  cp = '\t'; break;
+        case 'u': {
+            s32 hi = r->end - r->cur > 4 ? hex4(r->cur + 1) : -1;
+            if (hi < 0) {
+                json_error(r, "bad \\u escape");
+                return false;
+            }
+            r->cur += 4;
+            cp = (u32)hi;
+            // Surrogate pair
+            if (hi >= 0xD800 && hi <= 0xDBFF && r->end - r->cur > 6 &&
+                r->cur[1] == '\\' && r->cur[2] == 'u') {
+                s32 lo = hex4(r->cur + 3);
+                if (lo >= 0xDC00 && lo <= 0xDFFF) {
+                    cp = 0x10000 + (((u32)hi - 0xD800) << 10) + ((u32)lo - 0xDC00);
+                    r->cur += 6;
+                }
+            }
+            break;
+        }
+        default:
+            json_error(r, "bad escape '\\%c'", e ? e : ' ');
+            return false;
+        }
+        r->cur++;
+        if (!cut) put_codepoint(out, cap, &len, cp, &cut);
+    }
+
+    if (out && cap > 0) out[len] = '\0';
+    if (truncated) *truncated = cut;
+    r->need_comma = true;
+    return true;
+}
+
+bool json_skip_value(JsonReader *r) {
+    switch (json_peek(r)) {
+    case JSON_OBJECT:
+        if (!json_begin_object(r)) return false;
+        while (json_next_key(r, NULL, 0))
+            if (!json_skip_value(r)) return false;
+        return !r->failed;
+    case JSON_ARRAY:
+        if (!json_begin_array(r)) return false;
+        while (json_next_element(r))
+            if (!json_skip_value(r)) return false;
+        return !r->failed;
+    case JSON_STRING:
+        return json_read_string(r, NULL, 0, NULL);
+    case JSON_NUMBER: {
+        double v;
+        return json_read_number(r, &v);
+    }
+    case JSON_BOOL: {
+        bool b;
+        return json_read_bool(r, &b);
+    }
+    case JSON_NULL:
+        r->tok = r->cur;
+        return match_literal(r, "null");
+    default:
+        if (!r->failed) {
+            if (r->cur < r->end) json_error(r, "unexpected character '%c'", *r->cur);
+            else                 json_error(r, "unexpected end of input");
+        }
+        return false;
+    }
+}
+
+void json_mark(JsonReader *r) {
+    skip_ws(r);
+    r->tok = r->cur;
+}
+
+bool json_end(JsonReader *r) {
+    if (r->failed) return false;
+    skip_ws(r);
+    if (r->cur < r->end && *r->cur != '\0') {
+        json_error(r, "unexpected content after the top-level value");
+        return false;
+    }
+    return true;
+}
+
+// ---------------------------------------------------------------------------
+// Writer
+// ---------------------------------------------------------------------------
+
+void json_writer_init(JsonWriter *w, SDL_IOStream *io) {
+    memset(w, 0, sizeof(*w));
+    w->io    = io;
+    w->first = true;
+    w->ok    = true;
+}
+
+static void flush(JsonWriter *w) {
+    if (w->len > 0 && SDL_WriteIO(w->io, w->buf, w->len) != w->len)
+        w->ok = false;
+    w->len = 0;
+}
+
+static void put(JsonWriter *w, const char *s, size_t n) {
+    if (w->len + n > sizeof(w->buf)) flush(w);
+    if (n > sizeof(w->buf)) {
+        if (SDL_WriteIO(w->io, s, n) != n) w->ok = false;
+        return;
+    }
+    memcpy(w->buf + w->len, s, n);
+    w->len += n;
+}
+
+static void puts_(JsonWriter *w, const char *s) {
+    put(w, s, strlen(s));
+}
+
+static void newline(JsonWriter *w, s32 depth) {
+    put(w, "\n", 1);
+    for (s32 i = 0; i < depth; i++) put(w, "    ", 4);
+}
+
+// Separator and indentation before a key or array element
+static void item(JsonWriter *w) {
+    if (!w->first) put(w, ",", 1);
+    if (w->inline_array) {
+        if (!w->first) put(w, " ", 1);
+    } else if (w->depth > 0) {
+        newline(w, w->depth);
+    }
+    w->first = false;
+}
+
+// Before any value; a key has already placed it
+static void value(JsonWriter *w) {
+    if (w->after_key) {
+        w->after_key = false;
+        return;
+    }
+    if (w->depth > 0) item(w);
+}
+
+bool json_writer_finish(JsonWriter *w) {
+    put(w, "\n", 1);
+    flush(w);
+    return w->ok;
+}
+
+static void put_string(JsonWriter *w, const char *s) {
+    put(w, "\"", 1);
+    for (const char *p = s; *p; p++) {
+        u8 c = (u8)*p;
+        if (c == '"' || c == '\\') {
+            char esc[2] = { '\\', (char)c };
+            put(w, esc, 2);
+        } else if (c < 0x20) {
+            char esc[8];
+            snprintf(esc, sizeof(esc), "\\u%04x", c);
+            puts_(w, esc);
+        } else {
+            put(w, p, 1);
+        }
+    }
+    put(w, "\"", 1);
+}
+
+void json_write_key(JsonWriter *w, const char *key) {
+    item(w);
+    put_string(w, key);
+    put(w, ": ", 2);
+    w->after_key = true;
+}
+
+static void open_container(JsonWriter *w, char c) {
+    value(w);
+    put(w, &c, 1);
+    w->depth++;
+    w->first = true;
+}
+
+static void close_container(JsonWriter *w, char c) {
+    w->depth--;
+    if (!w->first && !w->inline_array) newline(w, w->depth);
+    put(w, &c, 1);
+    w->first        = false;
+    w->inline_array = false;
+}
+
+void json_begin_write_object(JsonWriter *w) {
+    open_container(w, '{');
+}
+
+void json_end_write_object(JsonWriter *w) {
+    close_container(w, '}');
+}
+
+void json_begin_write_array(JsonWriter *w, bool inline_values) {
+    open_container(w, '[');
+    w->inline_array = inline_values;
+}
+
+void json_end_write_array(JsonWriter *w) {
+    close_container(w, ']');
+}
+
+void json_write_string(JsonWriter *w, const char *s) {
+    value(w);
+    put_string(w, s);
+}
+
+void json_write_f32(JsonWriter *w, f32 v) {
+    value(w);
+    if (!isfinite(v)) v = 0.0f;   // JSON has no inf/nan
+    char tmp[32];
+    for (s32 prec = 6; prec <= 9; prec++) {
+        snprintf(tmp, sizeof(tmp), "%.*g", prec, (double)v);
+        if (strtof(tmp, NULL) == v) break;
+    }
+    puts_(w, tmp);
+}
+
+void json_write_int(JsonWriter *w, s64 v) {
+    value(w);
+    char tmp[32];
+    snprintf(tmp, sizeof(tmp), "%lld", (long long)v);
+    puts_(w, tmp);
+}
+
+void json_write_bool(JsonWriter *w, bool v) {
+    value(w);
+    puts_(w, v ? "true" : "false");
+}
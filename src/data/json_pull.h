@@ -0,0 +1,97 @@
+#pragma once
+#include <stdbool.h>
+#include <stddef.h>
+#include <SDL3/SDL.h>
+#include "utils/q_util.h"
+
+// Pull-style JSON reader and streaming writer. Neither builds a tree or
+// allocates: the reader walks a caller-owned, NUL-terminated buffer once and
+// hands values straight to the caller; the writer formats into a small
+// fixed buffer and streams it out.
+//
+// Reader errors carry the line and column of the offending token and stop
+// the parse: every call after the first error returns false.
+
+typedef enum {
+    JSON_NONE,       // end of input or after an error
+    JSON_OBJECT,
+    JSON_ARRAY,
+    JSON_STRING,
+    JSON_NUMBER,
+    JSON_BOOL,
+    JSON_NULL,
+} JsonType;
+
+typedef struct {
+    const char *path;        // for messages
+    const char *cur;
+    const char *end;
+    const char *line_start;
+    const char *tok;         // start of the last value read, for warnings
+    s32  line;
+    s32  depth;
+    bool need_comma;         // a value was just read inside a container
+    bool failed;
+    char error[256];         // "path:line:col: message"
+} JsonReader;
+
+void json_reader_init(JsonReader *r, const char *path, const char *text, size_t size);
+
+// Type of the next value, without consuming it
+JsonType json_peek(JsonReader *r);
+
+// Containers: begin, then loop on json_next_key / json_next_element, which
+// return false at the closing bracket (or on error; check r->failed).
+bool json_begin_object(JsonReader *r);
+bool json_next_key(JsonReader *r, char *key, size_t cap);
+bool json_begin_array(JsonReader *r);
+bool json_next_element(JsonReader *r);
+
+bool json_read_number(JsonReader *r, double *out);
+bool json_read_bool(JsonReader *r, bool *out);
+// Decodes escapes; a value longer than `cap - 1` bytes is cut short and
+// `*truncated` set
+bool json_read_string(JsonReader *r, char *out, size_t cap, bool *truncated);
+bool json_skip_value(JsonReader *r);
+// Point warnings at the next token, before skipping it
+void json_mark(JsonReader *r);
+// Only whitespace may follow the top-level value
+bool json_end(JsonReader *r);
+
+// Record an error at the next token (first error wins)
+void json_error(JsonReader *r, SDL_PRINTF_FORMAT_STRING const char *fmt, ...) SDL_PRINTF_VARARG_FUNC(2);
+// Log a non-fatal problem at the last token read
+void json_warn(const JsonReader *r, SDL_PRINTF_FORMAT_STRING const char *fmt, ...) SDL_PRINTF_VARARG_FUNC(2);
+
+// ---------------------------------------------------------------------------
+// Writer: 4-space indented, one key per line, short arrays inline
+// ---------------------------------------------------------------------------
+
+#define JSON_WRITER_BUF 1024
+
+typedef struct {
+    SDL_IOStream *io;
+    s32  depth;
+    bool first;              // nothing written yet in the current container
+    bool inline_array;       // inside an array written on one line
+    bool after_key;          // next value follows a key on the same line
+    bool ok;
+    size_t len;
+    char buf[JSON_WRITER_BUF];
+} JsonWriter;
+
+void json_writer_init(JsonWriter *w, SDL_IOStream *io);
+// Flush; false if any write failed
+bool json_writer_finish(JsonWriter *w);
+
+void json_write_key(JsonWriter *w, const char *key);
+void json_begin_write_object(JsonWriter *w);
+void json_end_write_object(JsonWriter *w);
+// `inline_values`: keep a short array of scalars on one line
+void json_begin_write_array(JsonWriter *w, bool inline_values);
+void json_end_write_array(JsonWriter *w);
+void json_write_string(JsonWriter *w, const char *s);
+// Shortest decimal that reads back as the same f32
+void json_write_f32(JsonWriter *w, f32 v);
+void json_write_int(JsonWriter *w, s64 v);
+void json_write_bool(JsonWriter *w, bool v);
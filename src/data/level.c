@@ -0,0 +1,127 @@
+#include "data/level.h"
+#include "data/level_bin.h"
+#include "data/level_pack.h"
+#include "data/json.h"
+#include <SDL3/SDL.h>
+#include <string.h>
+
+void level_desc_defaults(LevelDesc *desc) {
+    memset(desc, 0, sizeof(*desc));
+    desc->ship_density   = 1.0f;
+    desc->fleet_count    = 1;
+    desc->fleet_required = 1;
+    desc->difficulty     = 1;
+}
+
+u32 level_planet_seed(Vec2 pos, s32 index) {
+    u32 hx, hy;
+    memcpy(&hx, &pos.x, sizeof(hx));
+    memcpy(&hy, &pos.y, sizeof(hy));
+    return hx * 2654435761u ^ hy * 2246822519u ^ (u32)index;
+}
+
+void level_desc_apply(const LevelDesc *desc, Game *game) {
+    // Rotation speed varies by type
+    static const f32 base_speeds[PLANET_TYPE_COUNT] = { 2.0f, 3.0f, 8.0f, 1.5f, 5.0f };
+
+    game->cam.ppm          = desc->ppm;
+    game->bounds_min       = desc->bounds_min;
+    game->bounds_max       = desc->bounds_max;
+    game->ships[0].pos     = desc->start_pos;
+    game->ships[0].radius  = desc->ship_radius;
+    game->vel_max          = desc->vel_max;
+    game->goal.pos         = desc->goal_pos;
+    game->goal.radius      = desc->goal_radius;
+    game->fleet_count      = CLAMP(desc->fleet_count, 1, MAX_FLEET);
+    game->required_ships   = CLAMP(desc->fleet_required, 1, game->fleet_count);
+    game->show_field       = (desc->flags & LEVEL_FLAG_SHOW_FIELD) != 0;
+
+    game->planet_count = CLAMP(desc->planet_count, 0, MAX_PLANETS);
+    for (s32 i = 0; i < game->planet_count; i++) {
+        const LevelPlanet *src = &desc->planets[i];
+        Planet *p = &game->planets[i];
+        p->pos            = src->pos;
+        p->radius         = src->radius;
+        p->mu             = src->mu;
+        p->eps            = src->eps;
+        p->seed           = src->seed;
+        p->type           = (PlanetType)(src->type % PLANET_TYPE_COUNT);
+        p->rotation_speed = base_speeds[p->type];
+        p->rotation_angle = 0.0f;
+        p->tex_id         = 0;
+    }
+}
+
+static bool has_extension(const char *path, const char *ext) {
+    size_t len = strlen(path), ext_len = strlen(ext);
+    return len >= ext_len && SDL_strcasecmp(path + len - ext_len, ext) == 0;
+}
+
+// Entry `id` of the pack at `pack_path`, or -1
+static s32 pack_entry(const char *pack_path, const char *id, const LevelPack **pack) {
+    *pack = level_pack_get(pack_path);
+    s32 i = *pack ? level_pack_find(*pack, id) : -1;
+    if (i < 0) SDL_Log("level: no level '%s' in '%s'", id, pack_path);
+    return i;
+}
+
+bool level_read(const char *path, LevelBytes *bytes) {
+    *bytes = (LevelBytes){0};
+    char pack_path[256];
+    const char *id;
+    if (level_pack_split_ref(path, pack_path, sizeof(pack_path), &id)) {
+        const LevelPack *pack;
+        s32 i = pack_entry(pack_path, id, &pack);
+        if (i < 0) return false;
+        bytes->data = level_pack_view(pack, i, &bytes->size);
+        if (!bytes->data && !pack->map)
+            bytes->data = bytes->owned = level_pack_read(pack, i, &bytes->size);
+        return bytes->data != NULL;
+    }
+    bytes->data = bytes->owned = SDL_LoadFile(path, &bytes->size);
+    return bytes->data != NULL;
+}
+
+void level_bytes_free(LevelBytes *bytes) {
+    SDL_free(bytes->owned);
+    *bytes = (LevelBytes){0};
+}
+
+const LevelDesc *level_parse(const char *path, const void *data, size_t size,
+                             LevelDesc *scratch) {
+    char pack_path[256];
+    const char *id;
+    if (level_pack_split_ref(path, pack_path, sizeof(pack_path), &id) ||
+        has_extension(path, ".gbl")) {
+        const LevelDesc *view = level_bin_view(data, size);
+        if (!view)
+            SDL_Log("level: '%s' is not a valid version %d level", path, LEVEL_BIN_VERSION);
+        return view;
+    }
+    return json_parse_desc(path, data, size, scratch) ? scratch : NULL;
+}
+
+bool level_load(const char *path, Game *game) {
+    char pack_path[256];
+    const char *id;
+    if (level_pack_split_ref(path, pack_path, sizeof(pack_path), &id)) {
+        LevelBytes bytes;
+        LevelDesc scratch;
+        const LevelDesc *desc = NULL;
+        if (level_read(path, &bytes))
+            desc = level_parse(path, bytes.data, bytes.size, &scratch);
+        if (desc) level_desc_apply(desc, game);
+        level_bytes_free(&bytes);
+        return desc != NULL;
+    }
+
+    if (!has_extension(path, ".gbl"))
+        return json_load(path, game);
+
+    LevelBinView view;
+    if (!level_bin_open(path, &view))
+        return false;
+    level_desc_apply(view.desc, game);
+    level_bin_close(&view);
+    return true;
+}
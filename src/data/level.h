@@ -0,0 +1,75 @@
+#pragma once
+#include <stdbool.h>
+#include "game/game.h"
+
+// Everything a level file describes, with derived values (planet seeds and
+// types) already resolved. Fixed-size and plain-old-data: it is also the
+// body of a compiled .gbl file byte for byte (data/level_bin.h), so any
+// layout change must bump LEVEL_BIN_VERSION.
+
+#define LEVEL_NAME_MAX 64
+
+#define LEVEL_FLAG_SHOW_FIELD  (1u << 0)   // gravity field overlay on at start
+#define LEVEL_FLAG_ALLOW_SINK  (1u << 1)
+#define LEVEL_FLAG_ALLOW_REPEL (1u << 2)
+
+typedef struct {
+    Vec2 pos;
+    f32  radius;
+    f32  mu;
+    f32  eps;
+    u32  seed;
+    u32  type;       // PlanetType
+    u32  reserved;
+} LevelPlanet;
+
+typedef struct LevelDesc {
+    char name[LEVEL_NAME_MAX];
+    f32  ppm;
+    Vec2 bounds_min;
+    Vec2 bounds_max;
+    Vec2 start_pos;
+    f32  vel_max;
+    f32  ship_radius;
+    f32  ship_density;
+    f32  ship_restitution;
+    Vec2 goal_pos;
+    f32  goal_radius;
+    s32  fleet_count;
+    s32  fleet_required;
+    u32  flags;      // LEVEL_FLAG_*
+    s32  allow_max;
+    s32  difficulty; // 1 (easiest) and up, for level selection
+    s32  planet_count;
+    LevelPlanet planets[MAX_PLANETS];
+} LevelDesc;
+
+// Values for fields a level file leaves out
+void level_desc_defaults(LevelDesc *desc);
+// Seed derived from position, for planets authored without one
+u32  level_planet_seed(Vec2 pos, s32 index);
+// Copy into a game fresh from game_init's reset
+void level_desc_apply(const LevelDesc *desc, Game *game);
+
+// Load by extension: .gbl is mapped and used in place, anything else is
+// parsed as JSON. "<pack>.gbp#<id>" loads one level from a pack
+// (data/level_pack.h).
+bool level_load(const char *path, Game *game);
+// Raw bytes behind a level path, as level_load would read them: a pack
+// entry is used in place in the mapped pack (natively), anything else is
+// read into a heap copy. `data` stays valid until level_bytes_free.
+typedef struct {
+    const void *data;
+    size_t      size;
+    void       *owned;   // heap copy to free; NULL for a view into a pack
+} LevelBytes;
+
+bool level_read(const char *path, LevelBytes *bytes);
+void level_bytes_free(LevelBytes *bytes);
+// Decode bytes from level_read: a .gbl image for pack entries and .gbl
+// files, otherwise JSON text (NUL-terminated, as level_read returns it).
+// An image is used in place, so the result points into `data`; JSON is
+// decoded into `scratch`. NULL on failure. Touches no files, so it may run
+// on any thread.
+const LevelDesc *level_parse(const char *path, const void *data, size_t size,
+                             LevelDesc *scratch);
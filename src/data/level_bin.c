@@ -0,0 +1,105 @@
+#include "data/level_bin.h"
+#include "data/fs.h"
+#include <SDL3/SDL.h>
+#include <string.h>
+
+// The body is written with the host's struct layout; every supported
+// target is little-endian with natural 4-byte alignment.
+SDL_COMPILE_TIME_ASSERT(level_bin_header_size, sizeof(LevelBinHeader) == 32);
+SDL_COMPILE_TIME_ASSERT(level_planet_size, sizeof(LevelPlanet) == 32);
+SDL_COMPILE_TIME_ASSERT(level_desc_size,
+                        sizeof(LevelDesc) == 144 + MAX_PLANETS * sizeof(LevelPlanet));
+SDL_COMPILE_TIME_ASSERT(level_bin_image_size,
+                        sizeof(LevelBinImage) == sizeof(LevelBinHeader) + sizeof(LevelDesc));
+SDL_COMPILE_TIME_ASSERT(level_bin_little_endian, SDL_BYTEORDER == SDL_LIL_ENDIAN);
+
+const LevelDesc *level_bin_view(const void *data, size_t size) {
+    if (!data || size != sizeof(LevelBinHeader) + sizeof(LevelDesc))
+        return NULL;
+
+    const LevelBinHeader *hdr = data;
+    if (hdr->magic != LEVEL_BIN_MAGIC || hdr->version != LEVEL_BIN_VERSION ||
+        hdr->header_size != sizeof(LevelBinHeader) || hdr->body_size != sizeof(LevelDesc))
+        return NULL;
+
+    const LevelDesc *desc = (const LevelDesc *)((const u8 *)data + sizeof(LevelBinHeader));
+    if (fnv1a64(FNV1A64_SEED, desc, sizeof(LevelDesc)) != hdr->body_hash)
+        return NULL;
+    // Used in place, so anything that indexes or prints must be in range
+    if (desc->planet_count < 0 || desc->planet_count > MAX_PLANETS ||
+        memchr(desc->name, '\0', sizeof(desc->name)) == NULL)
+        return NULL;
+    return desc;
+}
+
+bool level_bin_open(const char *path, LevelBinView *view) {
+    memset(view, 0, sizeof(*view));
+    view->map = fs_map_file(path, &view->map_size);
+    if (!view->map) {
+        SDL_Log("level_bin: failed to map '%s'", path);
+        return false;
+    }
+
+    view->desc = level_bin_view(view->map, view->map_size);
+    if (!view->desc) {
+        SDL_Log("level_bin: '%s' is not a valid version %d level", path, LEVEL_BIN_VERSION);
+        level_bin_close(view);
+        return false;
+    }
+    return true;
+}
+
+void level_bin_close(LevelBinView *view) {
+    fs_unmap_file(view->map, view->map_size);
+    memset(view, 0, sizeof(*view));
+}
+
+void level_bin_build(const LevelDesc *desc, LevelBinImage *image) {
+    memset(image, 0, sizeof(*image));
+    LevelDesc *body = &image->body;
+    memcpy(body->name, desc->name, sizeof(body->name));
+    body->name[LEVEL_NAME_MAX - 1] = '\0';
+    body->ppm              = desc->ppm;
+    body->bounds_min       = desc->bounds_min;
+    body->bounds_max       = desc->bounds_max;
+    body->start_pos        = desc->start_pos;
+    body->vel_max          = desc->vel_max;
+    body->ship_radius      = desc->ship_radius;
+    body->ship_density     = desc->ship_density;
+    body->ship_restitution = desc->ship_restitution;
+    body->goal_pos         = desc->goal_pos;
+    body->goal_radius      = desc->goal_radius;
+    body->fleet_count      = desc->fleet_count;
+    body->fleet_required   = desc->fleet_required;
+    body->flags            = desc->flags;
+    body->allow_max        = desc->allow_max;
+    body->difficulty       = desc->difficulty;
+    body->planet_count     = CLAMP(desc->planet_count, 0, MAX_PLANETS);
+    for (s32 i = 0; i < body->planet_count; i++) {
+        body->planets[i] = desc->planets[i];
+        body->planets[i].reserved = 0;
+    }
+
+    image->header = (LevelBinHeader){
+        .magic       = LEVEL_BIN_MAGIC,
+        .version     = LEVEL_BIN_VERSION,
+        .header_size = sizeof(LevelBinHeader),
+        .body_size   = sizeof(LevelDesc),
+        .body_hash   = fnv1a64(FNV1A64_SEED, body, sizeof(*body)),
+    };
+}
+
+bool level_bin_save(const char *path, const LevelDesc *desc) {
+    LevelBinImage image;
+    level_bin_build(desc, &image);
+
+    SDL_IOStream *io = SDL_IOFromFile(path, "wb");
+    if (!io) {
+        SDL_Log("level_bin: failed to open '%s': %s", path, SDL_GetError());
+        return false;
+    }
+    bool ok = SDL_WriteIO(io, &image, sizeof(image)) == sizeof(image);
+    ok = SDL_CloseIO(io) && ok;
+    if (!ok) SDL_Log("level_bin: failed to write '%s'", path);
+    return ok;
+}
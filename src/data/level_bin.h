@@ -0,0 +1,52 @@
+#pragma once
+#include <stdbool.h>
+#include <stddef.h>
+#include "data/level.h"
+
+// Compiled level (.gbl): a header followed by a LevelDesc in its native,
+// little-endian layout, so a mapped file is used in place with no parsing.
+// Produced by GravityLevelCompile and the editor's export; JSON remains the
+// authoring format.
+//
+// On-disk layout (little-endian, header padded to 32 bytes):
+//   u32 magic 'GBLV'   u16 version   u16 header_size
+//   u32 body_size      u32 reserved
+//   u64 body_hash      u64 reserved
+//   LevelDesc body
+
+#define LEVEL_BIN_MAGIC   0x564C4247u    // "GBLV"
+#define LEVEL_BIN_VERSION 2
+
+typedef struct {
+    u32 magic;
+    u16 version;
+    u16 header_size;
+    u32 body_size;
+    u32 reserved0;
+    u64 body_hash;
+    u64 reserved1;
+} LevelBinHeader;
+
+// A whole .gbl file, as written
+typedef struct {
+    LevelBinHeader header;
+    LevelDesc      body;
+} LevelBinImage;
+
+typedef struct {
+    const LevelDesc *desc;   // points into the mapping
+    void  *map;
+    size_t map_size;
+} LevelBinView;
+
+// Validate an in-memory .gbl image and return its body, or NULL
+const LevelDesc *level_bin_view(const void *data, size_t size);
+
+// Map `path`; `view->desc` stays valid until level_bin_close
+bool level_bin_open(const char *path, LevelBinView *view);
+void level_bin_close(LevelBinView *view);
+
+// Fill `image` for `desc`; padding and unused planet slots are zeroed so
+// the bytes depend only on the level
+void level_bin_build(const LevelDesc *desc, LevelBinImage *image);
+bool level_bin_save(const char *path, const LevelDesc *desc);
@@ -0,0 +1,254 @@
+#include "data/level_pack.h"
+#include "data/level_bin.h"
+#include "data/fs.h"
+#include <SDL3/SDL.h>
+#include <stdio.h>
+#include <string.h>
+
+#define ALIGN 16
+
+SDL_COMPILE_TIME_ASSERT(level_pack_header_size, sizeof(LevelPackHeader) == 32);
+SDL_COMPILE_TIME_ASSERT(level_pack_entry_size, sizeof(LevelPackEntry) == 128);
+
+static LevelPack    open_packs[LEVEL_PACK_OPEN_MAX];
+static s32          open_count;
+static SDL_Mutex   *open_lock;     // created on first use, under open_spin
+static SDL_SpinLock open_spin;
+
+// Without a mapping, range reads fail on their own past the end of the file
+static bool entry_valid(const LevelPack *pack, const LevelPackEntry *e) {
+    bool in_map = !pack->map
+        || ((u64)e->payload_offset + e->payload_size <= pack->map_size
+            && (u64)e->thumb_offset + e->thumb_size <= pack->map_size);
+    return memchr(e->id, '\0', sizeof(e->id)) != NULL
+        && memchr(e->name, '\0', sizeof(e->name)) != NULL
+        && e->payload_size > 0
+        && (e->thumb_size == 0 || e->thumb_size == LEVEL_THUMB_SIZE)
+        && in_map;
+}
+
+static bool pack_bytes(const LevelPack *pack, u64 offset, size_t size, void *dst) {
+    if (!pack->map)
+        return fs_read_range(pack->path, offset, size, dst);
+    if (offset + size > pack->map_size)
+        return false;
+    memcpy(dst, pack->map + offset, size);
+    return true;
+}
+
+static void pack_close(LevelPack *pack) {
+    SDL_free(pack->entries);
+    fs_unmap_file((void *)pack->map, pack->map_size);
+    memset(pack, 0, sizeof(*pack));
+}
+
+static bool pack_open(LevelPack *pack, const char *path) {
+    snprintf(pack->path, sizeof(pack->path), "%s", path);
+#if !defined(__EMSCRIPTEN__)
+    pack->map = fs_map_file(path, &pack->map_size);
+    if (!pack->map) {
+        SDL_Log("level_pack: failed to map '%s'", path);
+        return false;
+    }
+#endif
+
+    LevelPackHeader hdr;
+    if (!pack_bytes(pack, 0, sizeof(hdr), &hdr)) {
+        SDL_Log("level_pack: failed to read '%s'", path);
+        pack_close(pack);
+        return false;
+    }
+    if (hdr.magic != LEVEL_PACK_MAGIC || hdr.version != LEVEL_PACK_VERSION ||
+        hdr.header_size != sizeof(hdr) || hdr.entry_size != sizeof(LevelPackEntry) ||
+        hdr.entry_count > LEVEL_PACK_MAX) {
+        SDL_Log("level_pack: '%s' is not a valid version %d pack", path, LEVEL_PACK_VERSION);
+        pack_close(pack);
+        return false;
+    }
+
+    size_t index_size = hdr.entry_count * sizeof(LevelPackEntry);
+    pack->entries = SDL_malloc(MAX(index_size, 1));
+    bool ok = pack->entries
+           && pack_bytes(pack, sizeof(hdr), index_size, pack->entries)
+           && fnv1a64(FNV1A64_SEED, pack->entries, index_size) == hdr.index_hash;
+    for (u32 i = 0; ok && i < hdr.entry_count; i++)
+        ok = entry_valid(pack, &pack->entries[i]);
+    if (!ok) {
+        SDL_Log("level_pack: '%s' has a damaged index", path);
+        pack_close(pack);
+        return false;
+    }
+
+    pack->count = (s32)hdr.entry_count;
+    return true;
+}
+
+const LevelPack *level_pack_get(const char *path) {
+    SDL_LockSpinlock(&open_spin);
+    if (!open_lock) open_lock = SDL_CreateMutex();
+    SDL_UnlockSpinlock(&open_spin);
+
+    // Open packs are never changed or freed before level_pack_release, so
+    // a pointer handed out here stays good without holding the lock
+    SDL_LockMutex(open_lock);
+    LevelPack *pack = NULL;
+    for (s32 i = 0; i < open_count && !pack; i++)
+        if (strcmp(open_packs[i].path, path) == 0)
+            pack = &open_packs[i];
+
+    if (!pack && open_count == LEVEL_PACK_OPEN_MAX) {
+        SDL_Log("level_pack: cannot open '%s', %d packs already open", path, open_count);
+    } else if (!pack && pack_open(&open_packs[open_count], path)) {
+        pack = &open_packs[open_count++];
+        SDL_Log("level_pack: '%s' lists %d levels", path, pack->count);
+    }
+    SDL_UnlockMutex(open_lock);
+    return pack;
+}
+
+void level_pack_release(void) {
+    for (s32 i = 0; i < open_count; i++)
+        pack_close(&open_packs[i]);
+    open_count = 0;
+    if (open_lock) SDL_DestroyMutex(open_lock);
+    open_lock = NULL;
+}
+
+s32 level_pack_find(const LevelPack *pack, const char *id) {
+    for (s32 i = 0; i < pack->count; i++)
+        if (strcmp(pack->entries[i].id, id) == 0)
+            return i;
+    return -1;
+}
+
+void level_pack_ref(const LevelPack *pack, s32 i, char *out, size_t cap) {
+    snprintf(out, cap, "%s#%s", pack->path, pack->entries[i].id);
+}
+
+bool level_pack_split_ref(const char *ref, char *path, size_t cap, const char **id) {
+    const char *hash = strrchr(ref, '#');
+    if (!hash) return false;
+    snprintf(path, cap, "%.*s", (int)(hash - ref), ref);
+    *id = hash + 1;
+    return true;
+}
+
+const void *level_pack_view(const LevelPack *pack, s32 i, size_t *size) {
+    *size = 0;
+    if (!pack->map || i < 0 || i >= pack->count) return NULL;
+
+    const LevelPackEntry *e = &pack->entries[i];
+    const void *data = pack->map + e->payload_offset;
+    if (!level_pack_verify(pack, i, data)) return NULL;
+    *size = e->payload_size;
+    return data;
+}
+
+void *level_pack_read(const LevelPack *pack, s32 i, size_t *size) {
+    *size = 0;
+    if (i < 0 || i >= pack->count) return NULL;
+
+    const LevelPackEntry *e = &pack->entries[i];
+    void *data = SDL_malloc(e->payload_size);
+    if (!data) return NULL;
+    if (!pack_bytes(pack, e->payload_offset, e->payload_size, data) ||
+        !level_pack_verify(pack, i, data)) {
+        SDL_free(data);
+        return NULL;
+    }
+    *size = e->payload_size;
+    return data;
+}
+
+bool level_pack_verify(const LevelPack *pack, s32 i, const void *data) {
+    const LevelPackEntry *e = &pack->entries[i];
+    if (fnv1a64(FNV1A64_SEED, data, e->payload_size) == e->hash) return true;
+    SDL_Log("level_pack: failed to read '%s' from '%s'", e->id, pack->path);
+    return false;
+}
+
+bool level_pack_read_thumb(const LevelPack *pack, s32 i, u8 *rgba) {
+    if (i < 0 || i >= pack->count) return false;
+    const LevelPackEntry *e = &pack->entries[i];
+    return e->thumb_size == LEVEL_THUMB_SIZE
+        && pack_bytes(pack, e->thumb_offset, e->thumb_size, rgba);
+}
+
+// ---------------------------------------------------------------------------
+// Writer
+// ---------------------------------------------------------------------------
+
+static u32 align_up(u32 x) {
+    return (x + ALIGN - 1) & ~(u32)(ALIGN - 1);
+}
+
+bool level_pack_save(const char *path, const LevelPackItem *items, s32 count) {
+    if (count < 0 || count > LEVEL_PACK_MAX) {
+        SDL_Log("level_pack: %d levels, at most %d fit in a pack", count, LEVEL_PACK_MAX);
+        return false;
+    }
+    for (s32 i = 0; i < count; i++) {
+        size_t len = strlen(items[i].id);
+        if (len == 0 || len >= LEVEL_PACK_ID_MAX || strchr(items[i].id, '#')) {
+            SDL_Log("level_pack: bad level id '%s'", items[i].id);
+            return false;
+        }
+        for (s32 j = 0; j < i; j++) {
+            if (strcmp(items[i].id, items[j].id) == 0) {
+                SDL_Log("level_pack: duplicate level id '%s'", items[i].id);
+                return false;
+            }
+        }
+    }
+
+    // Lay out: header, index, then each level's payload and thumbnail
+    u32 size = sizeof(LevelPackHeader) + (u32)count * sizeof(LevelPackEntry);
+    LevelPackEntry *entries = SDL_calloc(MAX(count, 1), sizeof(LevelPackEntry));
+    if (!entries) return false;
+    for (s32 i = 0; i < count; i++) {
+        LevelPackEntry *e = &entries[i];
+        snprintf(e->id, sizeof(e->id), "%s", items[i].id);
+        snprintf(e->name, sizeof(e->name), "%s", items[i].desc->name);
+        e->difficulty     = items[i].desc->difficulty;
+        e->payload_offset = size = align_up(size);
+        e->payload_size   = sizeof(LevelBinImage);
+        size += e->payload_size;
+        if (items[i].thumb) {
+            e->thumb_offset = size = align_up(size);
+            e->thumb_size   = LEVEL_THUMB_SIZE;
+            size += e->thumb_size;
+        }
+    }
+
+    u8 *file = SDL_calloc(1, size);
+    if (!file) {
+        SDL_free(entries);
+        return false;
+    }
+    for (s32 i = 0; i < count; i++) {
+        LevelPackEntry *e = &entries[i];
+        LevelBinImage *image = (LevelBinImage *)(file + e->payload_offset);
+        level_bin_build(items[i].desc, image);
+        e->hash = fnv1a64(FNV1A64_SEED, image, e->payload_size);
+        if (items[i].thumb)
+            memcpy(file + e->thumb_offset, items[i].thumb, LEVEL_THUMB_SIZE);
+    }
+
+    size_t index_size = (size_t)count * sizeof(LevelPackEntry);
+    LevelPackHeader hdr = {
+        .magic       = LEVEL_PACK_MAGIC,
+        .version     = LEVEL_PACK_VERSION,
+        .header_size = sizeof(LevelPackHeader),
+        .entry_size  = sizeof(LevelPackEntry),
+        .entry_count = (u32)count,
+        .index_hash  = fnv1a64(FNV1A64_SEED, entries, index_size),
+    };
+    memcpy(file, &hdr, sizeof(hdr));
+    memcpy(file + sizeof(hdr), entries, index_size);
+    SDL_free(entries);
+
+    bool ok = SDL_SaveFile(path, file, size);
+    if (!ok) SDL_Log("level_pack: failed to write '%s': %s", path, SDL_GetError());
+    SDL_free(file);
+    return ok;
+}
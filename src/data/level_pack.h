@@ -0,0 +1,97 @@
+#pragma once
+#include <stdbool.h>
+#include <stddef.h>
+#include "data/level.h"
+
+// Level pack (.gbp): every shipped level in one file, with an index up front
+// so the level menu can list hundreds of levels by reading only the index.
+// Natively the whole pack is mapped once and levels are used in place. The
+// web build reads a level's body and thumbnail by byte range when it is
+// picked, as an HTTP range request, so levels never add to the initial
+// download.
+//
+// On-disk layout (little-endian):
+//   u32 magic 'GBPK'   u16 version     u16 header_size
+//   u32 entry_size     u32 entry_count
+//   u64 index_hash     u64 reserved
+//   LevelPackEntry index[entry_count]
+//   payloads and thumbnails, each 16-byte aligned
+//
+// Each payload is a complete .gbl image (data/level_bin.h). A level inside
+// a pack is addressed as "<pack path>#<id>"; level_load and replays accept
+// that anywhere a level file path is accepted.
+
+#define LEVEL_PACK_MAGIC   0x4B504247u   // "GBPK"
+#define LEVEL_PACK_VERSION 1
+#define LEVEL_PACK_ID_MAX  32
+#define LEVEL_PACK_MAX     1024          // levels per pack
+
+// Thumbnails are RGBA8, row-major, top row first
+#define LEVEL_THUMB_W      64
+#define LEVEL_THUMB_H      36
+#define LEVEL_THUMB_SIZE   (LEVEL_THUMB_W * LEVEL_THUMB_H * 4)
+
+typedef struct {
+    u32 magic;
+    u16 version;
+    u16 header_size;
+    u32 entry_size;
+    u32 entry_count;
+    u64 index_hash;     // FNV-1a over the index
+    u64 reserved;
+} LevelPackHeader;
+
+typedef struct {
+    char id[LEVEL_PACK_ID_MAX];    // stable key: the source file stem
+    char name[LEVEL_NAME_MAX];     // display name
+    s32  difficulty;
+    u32  payload_offset;
+    u32  payload_size;
+    u32  thumb_offset;
+    u32  thumb_size;               // 0 or LEVEL_THUMB_SIZE
+    u32  reserved;
+    u64  hash;                     // FNV-1a over the payload
+} LevelPackEntry;
+
+typedef struct {
+    char path[256];
+    LevelPackEntry *entries;
+    s32  count;
+    const u8 *map;      // whole file, natively; NULL on the web
+    size_t    map_size;
+} LevelPack;
+
+// Index of the pack at `path`; NULL if missing or invalid. Read on first
+// use and kept, unchanged, until level_pack_release, so any thread may call
+// this and use the result (the replay verifier's workers and the level
+// loader do). At most LEVEL_PACK_OPEN_MAX packs are open at once.
+#define LEVEL_PACK_OPEN_MAX 4
+const LevelPack *level_pack_get(const char *path);
+// Free every open index; no other thread may be using one
+void level_pack_release(void);
+
+// Entry index for `id`, or -1
+s32  level_pack_find(const LevelPack *pack, const char *id);
+// "<pack path>#<id>" for entry `i`
+void level_pack_ref(const LevelPack *pack, s32 i, char *out, size_t cap);
+// Split a "<pack path>#<id>" reference; false for a plain file path
+bool level_pack_split_ref(const char *ref, char *path, size_t cap, const char **id);
+
+// Payload of entry `i` (a .gbl image) in place in the mapped pack, checked
+// against the index hash; valid until level_pack_release. NULL on failure,
+// and always on the web, which has no mapping: use level_pack_read there.
+const void *level_pack_view(const LevelPack *pack, s32 i, size_t *size);
+// Payload of entry `i` copied out, checked the same way. Free with SDL_free.
+void *level_pack_read(const LevelPack *pack, s32 i, size_t *size);
+// Hash check for a payload read some other way (entries[i].payload_size bytes)
+bool level_pack_verify(const LevelPack *pack, s32 i, const void *data);
+bool level_pack_read_thumb(const LevelPack *pack, s32 i, u8 *rgba);
+
+// Writer (GravityLevelCompile)
+typedef struct {
+    const char      *id;
+    const LevelDesc *desc;
+    const u8        *thumb;     // LEVEL_THUMB_SIZE bytes, or NULL
+} LevelPackItem;
+
+bool level_pack_save(const char *path, const LevelPackItem *items, s32 count);
@@ -0,0 +1,256 @@
+#include "data/replay.h"
+#include "data/fs.h"
+#include "data/level.h"
+#include <SDL3/SDL.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+// Upper bound on an encoded replay
+#define REPLAY_MAX_BYTES (16 + REPLAY_MAX_PATH + 3 * 5 \
+                          + REPLAY_MAX_INPUTS * 14 + REPLAY_MAX_CHECKS * 4)
+
+// ---------------------------------------------------------------------------
+// Hashing
+// ---------------------------------------------------------------------------
+
+static u32 f32_bits(f32 f) {
+    u32 u;
+    memcpy(&u, &f, sizeof(u));
+    return u;
+}
+
+u32 replay_checksum(const Game *game) {
+    u64 h = FNV1A64_SEED;
+    h = fnv1a64_u32(h, (u32)game->state);
+    h = fnv1a64_u32(h, (u32)game->alive_count);
+    h = fnv1a64_u32(h, (u32)game->arrived_count);
+
+    for (s32 i = 0; i < game->fleet_count; i++) {
+        const Ship *s = &game->ships[i];
+        h = fnv1a64_f32(h, s->pos.x);
+        h = fnv1a64_f32(h, s->pos.y);
+        h = fnv1a64_f32(h, s->vel.x);
+        h = fnv1a64_f32(h, s->vel.y);
+        h = fnv1a64_u32(h, (u32)s->alive | ((u32)s->arrived << 1));
+    }
+    return (u32)(h ^ (h >> 32));
+}
+
+// ---------------------------------------------------------------------------
+// Recording
+// ---------------------------------------------------------------------------
+
+bool replay_begin(Replay *r, const char *level_path) {
+    LevelBytes bytes;
+    bool ok = level_read(level_path, &bytes);
+    replay_begin_data(r, level_path, bytes.data, bytes.size);
+    if (!ok) SDL_Log("replay_begin: failed to read '%s'", level_path);
+    level_bytes_free(&bytes);
+    return ok;
+}
+
+void replay_begin_data(Replay *r, const char *level_path, const void *data, size_t size) {
+    memset(r, 0, sizeof(*r));
+    snprintf(r->level_path, sizeof(r->level_path), "%s", level_path);
+    r->outcome = GAME_STATE_AIM;
+    if (data) r->level_hash = fnv1a64(FNV1A64_SEED, data, size);
+}
+
+void replay_restart(Replay *r) {
+    u64 level_hash = r->level_hash;
+    char level_path[REPLAY_MAX_PATH];
+    memcpy(level_path, r->level_path, sizeof(level_path));
+
+    memset(r, 0, sizeof(*r));
+    r->level_hash = level_hash;
+    memcpy(r->level_path, level_path, sizeof(level_path));
+    r->outcome = GAME_STATE_AIM;
+}
+
+void replay_record_input(Replay *r, ReplayInputKind kind, u32 substep, Vec2 value) {
+    if (r->input_count >= REPLAY_MAX_INPUTS) return;
+    r->inputs[r->input_count++] = (ReplayInput){
+        .substep = substep,
+        .kind    = (u8)kind,
+        .value   = value,
+    };
+}
+
+void replay_record_substep(Replay *r, const Game *game) {
+    r->substep_count++;
+    if (r->substep_count % REPLAY_CHECK_INTERVAL == 0 &&
+        r->check_count < REPLAY_MAX_CHECKS)
+        r->checks[r->check_count++] = replay_checksum(game);
+}
+
+void replay_finish(Replay *r, GameState outcome) {
+    r->outcome = (u8)outcome;
+}
+
+// ---------------------------------------------------------------------------
+// Encoding
+// ---------------------------------------------------------------------------
+
+typedef struct {
+    u8    *data;
+    size_t pos, cap;
+    bool   ok;
+} ByteStream;
+
+static void put_u8(ByteStream *s, u8 v) {
+    if (s->pos >= s->cap) { s->ok = false; return; }
+    s->data[s->pos++] = v;
+}
+
+static void put_u16(ByteStream *s, u16 v) {
+    put_u8(s, (u8)v);
+    put_u8(s, (u8)(v >> 8));
+}
+
+static void put_u32(ByteStream *s, u32 v) {
+    for (int i = 0; i < 4; i++) put_u8(s, (u8)(v >> (i * 8)));
+}
+
+static void put_u64(ByteStream *s, u64 v) {
+    for (int i = 0; i < 8; i++) put_u8(s, (u8)(v >> (i * 8)));
+}
+
+static void put_varint(ByteStream *s, u32 v) {
+    while (v >= 0x80) {
+        put_u8(s, (u8)(v | 0x80));
+        v >>= 7;
+    }
+    put_u8(s, (u8)v);
+}
+
+static u8 get_u8(ByteStream *s) {
+    if (s->pos >= s->cap) { s->ok = false; return 0; }
+    return s->data[s->pos++];
+}
+
+static u16 get_u16(ByteStream *s) {
+    u16 v = get_u8(s);
+    return v | (u16)(get_u8(s) << 8);
+}
+
+static u32 get_u32(ByteStream *s) {
+    u32 v = 0;
+    for (int i = 0; i < 4; i++) v |= (u32)get_u8(s) << (i * 8);
+    return v;
+}
+
+static u64 get_u64(ByteStream *s) {
+    u64 v = 0;
+    for (int i = 0; i < 8; i++) v |= (u64)get_u8(s) << (i * 8);
+    return v;
+}
+
+static u32 get_varint(ByteStream *s) {
+    u32 v = 0;
+    for (int shift = 0; shift < 35; shift += 7) {
+        u8 b = get_u8(s);
+        v |= (u32)(b & 0x7F) << shift;
+        if (!(b & 0x80)) return v;
+    }
+    s->ok = false;
+    return 0;
+}
+
+static f32 bits_f32(u32 u) {
+    f32 f;
+    memcpy(&f, &u, sizeof(f));
+    return f;
+}
+
+bool replay_save(const Replay *r, const char *path) {
+    static u8 buf[REPLAY_MAX_BYTES];
+    ByteStream s = { .data = buf, .cap = sizeof(buf), .ok = true };
+
+    size_t path_len = strlen(r->level_path);
+
+    put_u32(&s, REPLAY_MAGIC);
+    put_u8(&s, REPLAY_VERSION);
+    put_u8(&s, r->outcome);
+    put_u16(&s, REPLAY_CHECK_INTERVAL);
+    put_u64(&s, r->level_hash);
+    put_u8(&s, (u8)path_len);
+    for (size_t i = 0; i < path_len; i++) put_u8(&s, (u8)r->level_path[i]);
+    put_varint(&s, r->substep_count);
+
+    put_varint(&s, (u32)r->input_count);
+    u32 prev = 0;
+    for (s32 i = 0; i < r->input_count; i++) {
+        const ReplayInput *in = &r->inputs[i];
+        put_varint(&s, in->substep - prev);
+        put_u8(&s, in->kind);
+        put_u32(&s, f32_bits(in->value.x));
+        put_u32(&s, f32_bits(in->value.y));
+        prev = in->substep;
+    }
+
+    put_varint(&s, (u32)r->check_count);
+    for (s32 i = 0; i < r->check_count; i++) put_u32(&s, r->checks[i]);
+
+    if (!s.ok) return false;
+
+    FILE *f = fopen(path, "wb");
+    if (!f) {
+        SDL_Log("replay_save: failed to open '%s'", path);
+        return false;
+    }
+    bool ok = fwrite(buf, 1, s.pos, f) == s.pos;
+    fclose(f);
+    return ok;
+}
+
+bool replay_load(Replay *r, const char *path) {
+    char *buf = NULL;
+    long size = 0;
+    if (!fs_read_file(path, &buf, &size))
+        return false;
+
+    ByteStream s = { .data = (u8 *)buf, .cap = (size_t)size, .ok = true };
+    memset(r, 0, sizeof(*r));
+
+    bool ok = get_u32(&s) == REPLAY_MAGIC
+           && get_u8(&s) == REPLAY_VERSION;
+    if (ok) {
+        r->outcome = get_u8(&s);
+        ok = get_u16(&s) == REPLAY_CHECK_INTERVAL;
+    }
+    if (ok) {
+        r->level_hash = get_u64(&s);
+        u8 path_len = get_u8(&s);
+        if (path_len >= REPLAY_MAX_PATH) ok = false;
+        for (u8 i = 0; ok && i < path_len; i++) r->level_path[i] = (char)get_u8(&s);
+        r->substep_count = get_varint(&s);
+    }
+    if (ok) {
+        u32 n = get_varint(&s);
+        if (n > REPLAY_MAX_INPUTS) ok = false;
+        u32 substep = 0;
+        for (u32 i = 0; ok && i < n; i++) {
+            ReplayInput *in = &r->inputs[i];
+            substep += get_varint(&s);
+            in->substep = substep;
+            in->kind    = get_u8(&s);
+            in->value.x = bits_f32(get_u32(&s));
+            in->value.y = bits_f32(get_u32(&s));
+        }
+        r->input_count = (s32)n;
+    }
+    if (ok) {
+        u32 n = get_varint(&s);
+        if (n > REPLAY_MAX_CHECKS) ok = false;
+        for (u32 i = 0; ok && i < n; i++) r->checks[i] = get_u32(&s);
+        r->check_count = (s32)n;
+    }
+
+    free(buf);
+    if (!ok || !s.ok) {
+        SDL_Log("replay_load: '%s' is not a valid v%d replay", path, REPLAY_VERSION);
+        return false;
+    }
+    return true;
+}
@@ -0,0 +1,67 @@
+#pragma once
+#include <stdbool.h>
+#include <stddef.h>
+#include "game/game.h"
+
+// Deterministic replays.
+//
+// A run is a pure function of the level file and the inputs applied at
+// fixed physics substep indices. A replay stores the level content hash,
+// those inputs, and a state checksum every REPLAY_CHECK_INTERVAL substeps so
+// a re-simulation can pinpoint where it diverged.
+//
+// On-disk layout (.gbr, little-endian, varints are LEB128):
+//   u32 magic 'GBRP'   u8 version   u8 outcome   u16 check_interval
+//   u64 level_hash     u8 path_len  char path[path_len]
+//   varint substep_count
+//   varint input_count  { varint substep_delta, u8 kind, f32 x, f32 y }*
+//   varint check_count  { u32 checksum }*
+
+#define REPLAY_MAGIC          0x50524247u   // "GBRP"
+#define REPLAY_VERSION        1
+#define REPLAY_CHECK_INTERVAL 60            // substeps between checksums (0.5 s)
+#define REPLAY_MAX_INPUTS     64
+#define REPLAY_MAX_CHECKS     4096          // ~34 minutes at 120 Hz
+#define REPLAY_MAX_PATH       128
+
+typedef enum {
+    REPLAY_INPUT_LAUNCH = 1,        // value = launch velocity
+    REPLAY_INPUT_PLACE_SINK,        // value = world position
+    REPLAY_INPUT_PLACE_REPEL,
+    REPLAY_INPUT_REMOVE,
+} ReplayInputKind;
+
+typedef struct {
+    u32  substep;   // applied before this substep runs
+    u8   kind;      // ReplayInputKind
+    Vec2 value;
+} ReplayInput;
+
+typedef struct Replay {
+    u64  level_hash;
+    char level_path[REPLAY_MAX_PATH];
+    u32  substep_count;
+    u8   outcome;                         // GameState when the run ended
+    s32  input_count;
+    ReplayInput inputs[REPLAY_MAX_INPUTS];
+    s32  check_count;
+    u32  checks[REPLAY_MAX_CHECKS];
+} Replay;
+
+// Checksum of the simulation state that must match between runs
+u32 replay_checksum(const Game *game);
+
+// Reset `r` for a new run of the level at `level_path` (hashes the file,
+// or the payload for a level in a pack).
+bool replay_begin(Replay *r, const char *level_path);
+// Same, from level bytes already in memory (as level_read returns them)
+void replay_begin_data(Replay *r, const char *level_path, const void *data, size_t size);
+// New attempt at the same level: keeps the path and level hash
+void replay_restart(Replay *r);
+void replay_record_input(Replay *r, ReplayInputKind kind, u32 substep, Vec2 value);
+// Call after every executed substep; samples a checksum on the interval.
+void replay_record_substep(Replay *r, const Game *game);
+void replay_finish(Replay *r, GameState outcome);
+
+bool replay_save(const Replay *r, const char *path);
+bool replay_load(Replay *r, const char *path);
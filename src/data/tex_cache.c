@@ -0,0 +1,307 @@
+#include "data/tex_cache.h"
+#include "data/fs.h"
+#include <SDL3/SDL.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#ifdef __EMSCRIPTEN__
+#include <emscripten.h>
+#endif
+
+#define DEFAULT_DIR     "cache/textures"
+#define WEB_DIR         "/cache"         // IDBFS mount point on the web build
+#define STALE_TMP_NS    (60 * SDL_NS_PER_SECOND)   // a store takes far less
+#define SAVE_DELAY_MS   1000             // IDBFS syncs are batched this far apart
+
+typedef struct {
+    u32 magic;
+    u16 version;
+    u16 reserved0;
+    u16 width;
+    u16 height;
+    u32 reserved1;
+    u64 key;
+    u64 payload_hash;
+} TexCacheHeader;
+
+SDL_COMPILE_TIME_ASSERT(tex_cache_header_size, sizeof(TexCacheHeader) == 32);
+
+static char cache_dir[256];
+static bool cache_ready;
+static bool cache_scanned;   // cache_bytes has been set by a scan
+static u64  cache_bytes;     // on disk as of the last scan, plus stores since
+
+// ---------------------------------------------------------------------------
+// Hashing
+// ---------------------------------------------------------------------------
+
+// FNV-style over 64-bit words with a fold per step; an order of magnitude
+// faster than the byte loop, which matters when validating 256 KB blobs.
+static u64 payload_hash(const u8 *p, size_t size) {
+    u64 h = FNV1A64_SEED;
+    size_t i = 0;
+    for (; i + 8 <= size; i += 8) {
+        u64 w;
+        memcpy(&w, p + i, sizeof(w));
+        h = (h ^ w) * 0x100000001b3ull;
+        h ^= h >> 32;
+    }
+    return fnv1a64(h, p + i, size - i);
+}
+
+// ---------------------------------------------------------------------------
+// Platform
+// ---------------------------------------------------------------------------
+
+#ifdef __EMSCRIPTEN__
+// The initial IDBFS populate is asynchronous; until it lands the directory
+// is empty and anything written would be clobbered by it.
+static bool idbfs_synced(void) {
+    return EM_ASM_INT({ return Module.gbTexCacheSynced ? 1 : 0; }) != 0;
+}
+
+// A sync copies the whole directory to IndexedDB, so the first change
+// schedules one SAVE_DELAY_MS out and later ones ride along with it.
+// `now` runs a scheduled sync at once (shutdown).
+static void idbfs_save(bool now) {
+    EM_ASM({
+        var save = function () {
+            Module.gbTexCacheSaveTimer = 0;
+            FS.syncfs(false, function (err) {
+                if (err) console.warn('tex_cache: IDBFS save failed', err);
+            });
+        };
+        if ($0) {
+            if (Module.gbTexCacheSaveTimer) {
+                clearTimeout(Module.gbTexCacheSaveTimer);
+                save();
+            }
+        } else if (!Module.gbTexCacheSaveTimer) {
+            Module.gbTexCacheSaveTimer = setTimeout(save, $1);
+        }
+    }, now, SAVE_DELAY_MS);
+}
+#endif
+
+static void entry_path(char *buf, size_t cap, u64 key, const char *ext) {
+    snprintf(buf, cap, "%s/%016llx.%s", cache_dir, (unsigned long long)key, ext);
+}
+
+// ---------------------------------------------------------------------------
+// Eviction
+// ---------------------------------------------------------------------------
+
+typedef struct {
+    char    *name;
+    u64      size;
+    SDL_Time mtime;
+} CacheFile;
+
+static int compare_oldest(const void *a, const void *b) {
+    const CacheFile *fa = a;
+    const CacheFile *fb = b;
+    return (fa->mtime > fb->mtime) - (fa->mtime < fb->mtime);
+}
+
+static bool has_suffix(const char *name, const char *suffix) {
+    size_t len = strlen(name), suffix_len = strlen(suffix);
+    return len >= suffix_len && strcmp(name + len - suffix_len, suffix) == 0;
+}
+
+// Every entry counts against the budget, however many there are. A .tmp
+// older than any store could take was left by a crash between write and
+// rename; it is deleted (a fresh one may be another process mid-store).
+// Resets cache_bytes to what is left.
+static void trim_to_budget(void) {
+    cache_scanned = true;
+    int count = 0;
+    char **names = SDL_GlobDirectory(cache_dir, "*", 0, &count);
+    if (!names) return;
+
+    CacheFile *files = SDL_malloc(sizeof(CacheFile) * (size_t)MAX(count, 1));
+    if (!files) {
+        SDL_free(names);
+        return;
+    }
+
+    SDL_Time now = 0;
+    SDL_GetCurrentTime(&now);
+    u64 total = 0;
+    int n = 0;
+    for (int i = 0; i < count; i++) {
+        bool tmp = has_suffix(names[i], ".tmp");
+        if (!tmp && !has_suffix(names[i], ".gbt")) continue;
+
+        char path[512];
+        snprintf(path, sizeof(path), "%s/%s", cache_dir, names[i]);
+        SDL_PathInfo info;
+        if (!SDL_GetPathInfo(path, &info)) continue;
+        if (tmp && now - info.modify_time > STALE_TMP_NS && SDL_RemovePath(path))
+            continue;
+        files[n++] = (CacheFile){ names[i], info.size, info.modify_time };
+        total += info.size;
+    }
+
+    if (total > TEX_CACHE_BUDGET) {
+        qsort(files, (size_t)n, sizeof(CacheFile), compare_oldest);
+        for (int i = 0; i < n && total > TEX_CACHE_BUDGET; i++) {
+            char path[512];
+            snprintf(path, sizeof(path), "%s/%s", cache_dir, files[i].name);
+            if (SDL_RemovePath(path))
+                total -= files[i].size;
+        }
+    }
+
+    cache_bytes = total;
+    SDL_free(files);
+    SDL_free(names);
+}
+
+// ---------------------------------------------------------------------------
+// Public API
+// ---------------------------------------------------------------------------
+
+bool tex_cache_init(const char *dir) {
+#ifdef __EMSCRIPTEN__
+    // Persisted to IndexedDB; the directory name is fixed by the mount
+    (void)dir;
+    snprintf(cache_dir, sizeof(cache_dir), "%s", WEB_DIR);
+    EM_ASM({
+        try { FS.mkdir('/cache'); } catch (e) {}
+        FS.mount(IDBFS, {}, '/cache');
+        Module.gbTexCacheSynced = 0;
+        FS.syncfs(true, function (err) {
+            if (err) console.warn('tex_cache: IDBFS load failed', err);
+            Module.gbTexCacheSynced = 1;
+        });
+    });
+#else
+    snprintf(cache_dir, sizeof(cache_dir), "%s", dir ? dir : DEFAULT_DIR);
+    if (!SDL_CreateDirectory(cache_dir)) {
+        SDL_Log("tex_cache: cannot create '%s': %s", cache_dir, SDL_GetError());
+        return false;
+    }
+    trim_to_budget();
+#endif
+    cache_ready = true;
+    return true;
+}
+
+void tex_cache_shutdown(void) {
+    if (!cache_ready) return;
+    tex_cache_commit();
+#ifdef __EMSCRIPTEN__
+    idbfs_save(true);
+#endif
+    cache_ready   = false;
+    cache_scanned = false;
+    cache_bytes   = 0;
+}
+
+bool tex_cache_load(u64 key, s32 width, s32 height, TexCacheEntry *out) {
+    memset(out, 0, sizeof(*out));
+    if (!cache_ready) return false;
+#ifdef __EMSCRIPTEN__
+    if (!idbfs_synced()) return false;
+#endif
+
+    char path[512];
+    entry_path(path, sizeof(path), key, "gbt");
+
+    size_t size = 0;
+    void *base = fs_map_file(path, &size);
+    if (!base) return false;
+
+    size_t payload = (size_t)width * (size_t)height * 4;
+    const TexCacheHeader *hdr = base;
+    bool ok = size == sizeof(TexCacheHeader) + payload
+           && hdr->magic   == TEX_CACHE_MAGIC
+           && hdr->version == TEX_CACHE_VERSION
+           && hdr->width   == (u16)width
+           && hdr->height  == (u16)height
+           && hdr->key     == key;
+    const u8 *pixels = (const u8 *)base + sizeof(TexCacheHeader);
+    if (ok && payload_hash(pixels, payload) != hdr->payload_hash)
+        ok = false;
+
+    if (!ok) {
+        // Truncated, stale format or corrupted: drop it so it gets rebuilt
+        SDL_Log("tex_cache: discarding invalid entry %016llx", (unsigned long long)key);
+        fs_unmap_file(base, size);
+        if (SDL_RemovePath(path))
+            cache_bytes -= MIN(cache_bytes, size);
+        return false;
+    }
+
+    out->pixels   = pixels;
+    out->width    = width;
+    out->height   = height;
+    out->map      = base;
+    out->map_size = size;
+    return true;
+}
+
+void tex_cache_release(TexCacheEntry *entry) {
+    if (entry->map)
+        fs_unmap_file(entry->map, entry->map_size);
+    memset(entry, 0, sizeof(*entry));
+}
+
+bool tex_cache_store(u64 key, s32 width, s32 height, const u8 *rgba) {
+    if (!cache_ready || width <= 0 || height <= 0 || width > 0xFFFF || height > 0xFFFF)
+        return false;
+#ifdef __EMSCRIPTEN__
+    if (!idbfs_synced()) return false;
+#endif
+
+    size_t payload = (size_t)width * (size_t)height * 4;
+    TexCacheHeader hdr = {
+        .magic        = TEX_CACHE_MAGIC,
+        .version      = TEX_CACHE_VERSION,
+        .width        = (u16)width,
+        .height       = (u16)height,
+        .key          = key,
+        .payload_hash = payload_hash(rgba, payload),
+    };
+
+    // Write under a temporary name and rename into place, so a reader (or
+    // a crash) never sees a half-written entry under the real key.
+    char tmp[512], path[512];
+    entry_path(tmp, sizeof(tmp), key, "tmp");
+    entry_path(path, sizeof(path), key, "gbt");
+
+    SDL_IOStream *io = SDL_IOFromFile(tmp, "wb");
+    if (!io) {
+        SDL_Log("tex_cache: failed to open '%s': %s", tmp, SDL_GetError());
+        return false;
+    }
+    bool ok = SDL_WriteIO(io, &hdr, sizeof(hdr)) == sizeof(hdr)
+           && SDL_WriteIO(io, rgba, payload) == payload;
+    ok = SDL_CloseIO(io) && ok;
+
+    if (ok) ok = SDL_RenamePath(tmp, path);
+    if (!ok) {
+        SDL_Log("tex_cache: failed to write entry %016llx", (unsigned long long)key);
+        SDL_RemovePath(tmp);
+        return false;
+    }
+    // Replacing an entry counts it twice; the next scan sets that straight
+    cache_bytes += sizeof(hdr) + payload;
+    return true;
+}
+
+void tex_cache_commit(void) {
+    if (!cache_ready) return;
+#ifdef __EMSCRIPTEN__
+    if (!idbfs_synced()) return;
+#endif
+    // The scan lists and stats the whole directory, so it runs only once
+    // stores have pushed the total over budget, or first thing on the web,
+    // where the directory is not populated until after init
+    if (!cache_scanned || cache_bytes > TEX_CACHE_BUDGET)
+        trim_to_budget();
+#ifdef __EMSCRIPTEN__
+    idbfs_save(false);
+#endif
+}
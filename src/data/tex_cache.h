@@ -0,0 +1,52 @@
+#pragma once
+#include <stdbool.h>
+#include <stddef.h>
+#include "utils/q_util.h"
+
+// Content-addressed on-disk cache of RGBA texture blobs.
+//
+// Callers derive a 64-bit key from everything that determines the pixels
+// (for planets: seed, type, size and generator version) and the cache maps
+// it to <dir>/<key>.gbt. Hits are memory-mapped on native builds and read
+// from an IDBFS mount on the web build, where tex_cache_commit() schedules
+// the directory to be persisted to IndexedDB, at most once a second.
+// Entries whose header or payload hash do not check out are deleted on
+// load; the directory is trimmed oldest-first to TEX_CACHE_BUDGET bytes
+// whenever the running total of stores goes over it.
+//
+// On-disk layout (.gbt, little-endian, header padded to 32 bytes):
+//   u32 magic 'GBTC'   u16 version   u16 reserved
+//   u16 width          u16 height    u32 reserved
+//   u64 key            u64 payload_hash
+//   u8  rgba[width * height * 4]
+
+#define TEX_CACHE_MAGIC   0x43544247u           // "GBTC"
+#define TEX_CACHE_VERSION 1
+#ifdef __EMSCRIPTEN__
+// IDBFS mirrors the whole directory in the wasm heap; keep it small
+#define TEX_CACHE_BUDGET  (8u * 1024 * 1024)
+#else
+#define TEX_CACHE_BUDGET  (64u * 1024 * 1024)   // bytes kept on disk
+#endif
+
+typedef struct {
+    const u8 *pixels;   // width * height * 4, tightly packed
+    s32 width, height;
+
+    void  *map;         // mapping (or heap copy) backing `pixels`
+    size_t map_size;
+} TexCacheEntry;
+
+// Mount/create the cache directory and trim it; NULL picks the default.
+// Without a successful init every lookup misses and stores are dropped.
+bool tex_cache_init(const char *dir);
+void tex_cache_shutdown(void);
+
+// Look up `key`; on a hit `out->pixels` stays valid until tex_cache_release
+bool tex_cache_load(u64 key, s32 width, s32 height, TexCacheEntry *out);
+void tex_cache_release(TexCacheEntry *entry);
+
+bool tex_cache_store(u64 key, s32 width, s32 height, const u8 *rgba);
+// Enforce the size budget and persist pending stores (IDBFS on the web).
+// Cheap while under budget; tex_cache_shutdown persists at once.
+void tex_cache_commit(void);
@@ -63,7 +63,7 @@ void editor_handle_event(EditorState *es, const SDL_Event *event,
                     p->type = (PlanetType)(p->seed % PLANET_TYPE_COUNT);
                     f32 base_speeds[] = { 2.0f, 3.0f, 8.0f, 1.5f, 5.0f };
                     p->rotation_speed = base_speeds[p->type];
-                    es->textures_dirty = true;
+                    es->planets_dirty |= 1u << idx;
                     es->selected       = idx;
                     es->adding_planet  = false;
                 }
@@ -131,12 +131,7 @@ void editor_handle_event(EditorState *es, const SDL_Event *event,
     case SDL_EVENT_KEY_DOWN:
         if (event->key.key == SDLK_DELETE || event->key.key == SDLK_BACKSPACE) {
             if (es->selected >= 0 && es->selected < es->game.planet_count) {
-                if (es->game.planets[es->selected].texture)
-                    SDL_DestroyTexture(es->game.planets[es->selected].texture);
-                for (s32 i = es->selected; i < es->game.planet_count - 1; i++)
-                    es->game.planets[i] = es->game.planets[i + 1];
-                es->game.planet_count--;
-                es->game.planets[es->game.planet_count].texture = NULL;
+                editor_delete_planet(es, es->selected);
                 es->selected = SEL_NONE;
             }
         }
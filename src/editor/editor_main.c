@@ -11,14 +11,14 @@
 #include "editor/editor_ui.h"
 #include "editor/editor_interact.h"
 #include "editor/editor_save.h"
-#include "render/render_background.h"
-#include "render/render_bounds.h"
-#include "render/render_planets.h"
-#include "render/render_field.h"
+#include "render/render.h"
 #include "render/planet_gen.h"
+#include "utils/jobs.h"
+#include "data/tex_cache.h"
 
 #include <math.h>
 
+// Initial window size in points; the window is resizable
 #define WINDOW_W 1280
 #define WINDOW_H 720
 
@@ -33,27 +33,9 @@ typedef struct {
 // Drawing helpers
 // -----------------------------------------------------------------------
 
-static void draw_circle_outline(SDL_Renderer *renderer,
-                                f32 cx, f32 cy, f32 r, s32 segments) {
-    f32 step = 2.0f * (f32)M_PI / segments;
-    f32 px = cx + r;
-    f32 py = cy;
-    for (s32 i = 1; i <= segments; i++) {
-        f32 a = step * i;
-        f32 nx = cx + r * cosf(a);
-        f32 ny = cy + r * sinf(a);
-        SDL_RenderLine(renderer, px, py, nx, ny);
-        px = nx;
-        py = ny;
-    }
-}
-
-static void draw_filled_circle(SDL_Renderer *renderer,
-                                f32 cx, f32 cy, f32 r) {
-    for (f32 dy = -r; dy <= r; dy += 1.0f) {
-        f32 dx = sqrtf(r * r - dy * dy);
-        SDL_RenderLine(renderer, cx - dx, cy + dy, cx + dx, cy + dy);
-    }
+// 1-pixel circle outline through the frame batcher
+static void draw_circle_outline(f32 cx, f32 cy, f32 r, s32 segments, SDL_FColor color) {
+    batch_ring(cx, cy, r - 0.5f, r + 0.5f, segments, color);
 }
 
 // -----------------------------------------------------------------------
@@ -72,7 +54,8 @@ SDL_AppResult SDL_AppInit(void **appstate, int argc, char *argv[]) {
         return SDL_APP_FAILURE;
     }
 
-    app->window = SDL_CreateWindow("GravityBoost Editor", WINDOW_W, WINDOW_H, 0);
+    app->window = SDL_CreateWindow("GravityBoost Editor", WINDOW_W, WINDOW_H,
+                                   SDL_WINDOW_RESIZABLE | SDL_WINDOW_HIGH_PIXEL_DENSITY);
     if (!app->window) {
         SDL_Log("SDL_CreateWindow failed: %s", SDL_GetError());
         return SDL_APP_FAILURE;
@@ -90,6 +73,11 @@ SDL_AppResult SDL_AppInit(void **appstate, int argc, char *argv[]) {
     }
 
     app->last_ticks = SDL_GetTicks();
+    // Editing wants crisp lines at native resolution; no adaptation
+    render_scale_set(RENDER_SCALE_MAX);
+    background_init(0);
+    jobs_init(0);
+    tex_cache_init(NULL);
 
     editor_state_defaults(&app->es);
 
@@ -110,6 +98,14 @@ SDL_AppResult SDL_AppEvent(void *appstate, SDL_Event *event) {
     if (event->type == SDL_EVENT_QUIT)
         return SDL_APP_SUCCESS;
 
+    // Render target contents are gone: the planet atlas and static layer
+    if (event->type == SDL_EVENT_RENDER_TARGETS_RESET ||
+        event->type == SDL_EVENT_RENDER_DEVICE_RESET) {
+        planet_textures_restore(app->renderer, &app->es.game);
+        static_layer_invalidate();
+        return SDL_APP_CONTINUE;
+    }
+
     // Let ImGui have priority
     bool imgui_mouse = igGetIO_Nil()->WantCaptureMouse;
     bool imgui_kb    = igGetIO_Nil()->WantCaptureKeyboard;
@@ -136,12 +132,14 @@ SDL_AppResult SDL_AppIterate(void *appstate) {
     f32 dt  = (f32)(now - app->last_ticks) / 1000.0f;
     app->last_ticks = now;
 
-    // Regenerate planet textures if something changed
-    if (es->textures_dirty) {
-        planet_textures_destroy(&es->game);
-        planet_textures_generate(app->renderer, &es->game);
-        es->textures_dirty = false;
+    // Retexture only the planets that changed: a preview now, full
+    // resolution once the background refine lands
+    for (s32 i = 0; i < es->game.planet_count; i++) {
+        if (es->planets_dirty & (1u << i))
+            planet_texture_refresh(app->renderer, &es->game.cam, &es->game.planets[i]);
     }
+    es->planets_dirty = 0;
+    planet_gen_poll(app->renderer, &es->game);
 
     // Spin planet textures
     for (s32 i = 0; i < es->game.planet_count; i++) {
@@ -151,11 +149,13 @@ SDL_AppResult SDL_AppIterate(void *appstate) {
     }
 
     // ---- Render ----
+    render_scale_begin(app->renderer, app->window, &es->game.cam);
     SDL_SetRenderDrawColor(app->renderer, 10, 10, 18, 255);
     SDL_RenderClear(app->renderer);
 
+    batch_begin(app->renderer);
     render_background(app->renderer, dt);
-    render_bounds(app->renderer, &es->game);
+    render_static_layer(app->renderer, &es->game);
     render_planets(app->renderer, &es->game);
 
     if (es->game.show_field)
@@ -167,11 +167,11 @@ SDL_AppResult SDL_AppIterate(void *appstate) {
         f32 sx = world_to_screen_x(cam, es->game.ships[0].pos.x);
         f32 sy = world_to_screen_y(cam, es->game.ships[0].pos.y);
 
-        SDL_SetRenderDrawBlendMode(app->renderer, SDL_BLENDMODE_BLEND);
-        SDL_SetRenderDrawColor(app->renderer, 100, 180, 255, 200);
-        draw_filled_circle(app->renderer, sx, sy, 8.0f);
-        SDL_SetRenderDrawColor(app->renderer, 200, 220, 255, 255);
-        draw_circle_outline(app->renderer, sx, sy, 10.0f, 24);
+        batch_set_blend(SDL_BLENDMODE_BLEND);
+        if (screen_circle_visible(cam, sx, sy, 11.0f)) {
+            batch_circle(sx, sy, 8.0f, 24, color_u8(100, 180, 255, 200));
+            draw_circle_outline(sx, sy, 10.0f, 24, color_u8(200, 220, 255, 255));
+        }
     }
 
     // Selection highlight (yellow ring)
@@ -198,12 +198,9 @@ SDL_AppResult SDL_AppIterate(void *appstate) {
             valid = true;
         }
 
-        if (valid) {
-            SDL_SetRenderDrawBlendMode(app->renderer, SDL_BLENDMODE_BLEND);
-            SDL_SetRenderDrawColor(app->renderer, 255, 255, 0, 180);
-            draw_circle_outline(app->renderer, sx, sy, sr, 48);
-            SDL_SetRenderDrawColor(app->renderer, 255, 255, 0, 80);
-            draw_circle_outline(app->renderer, sx, sy, sr + 2.0f, 48);
+        if (valid && screen_circle_visible(cam, sx, sy, sr + 3.0f)) {
+            draw_circle_outline(sx, sy, sr, 48, color_u8(255, 255, 0, 180));
+            draw_circle_outline(sx, sy, sr + 2.0f, 48, color_u8(255, 255, 0, 80));
         }
     }
 
@@ -231,14 +228,13 @@ SDL_AppResult SDL_AppIterate(void *appstate) {
             valid = true;
         }
 
-        if (valid) {
-            SDL_SetRenderDrawBlendMode(app->renderer, SDL_BLENDMODE_BLEND);
-            SDL_SetRenderDrawColor(app->renderer, 255, 255, 255, 80);
-            draw_circle_outline(app->renderer, sx, sy, sr, 48);
+        if (valid && screen_circle_visible(cam, sx, sy, sr + 1.0f)) {
+            draw_circle_outline(sx, sy, sr, 48, color_u8(255, 255, 255, 80));
         }
     }
 
-    SDL_SetRenderDrawBlendMode(app->renderer, SDL_BLENDMODE_NONE);
+    batch_flush();
+    render_scale_end(app->renderer);
 
     // ImGui
     ImGui_SDL3_NewFrame();
@@ -256,6 +252,11 @@ void SDL_AppQuit(void *appstate, SDL_AppResult result) {
     if (!app) return;
 
     planet_textures_destroy(&app->es.game);
+    planet_gen_shutdown();
+    tex_cache_shutdown();
+    static_layer_shutdown();
+    render_scale_shutdown();
+    jobs_shutdown();
     ImGui_SDL3_Shutdown();
 
     if (app->renderer) SDL_DestroyRenderer(app->renderer);
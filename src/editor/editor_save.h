@@ -1,8 +1,12 @@
 #pragma once
 
 #include "editor/editor_state.h"
+#include "data/level.h"
 
 struct SDL_Renderer;
 
 bool editor_save(const EditorState *es, const char *path);
+// Compiled form of the edited level (data/level_bin.h)
+void editor_level_desc(const EditorState *es, LevelDesc *desc);
+bool editor_export_gbl(const EditorState *es, const char *path);
 bool editor_load(EditorState *es, const char *path, struct SDL_Renderer *renderer);
@@ -1,4 +1,5 @@
 #include "editor/editor_state.h"
+#include "render/planet_gen.h"
 #include <string.h>
 #include <stdio.h>
 
@@ -7,7 +8,7 @@ void editor_state_defaults(EditorState *es) {
 
     snprintf(es->name, sizeof(es->name), "New Level");
 
-    // Camera / view
+    // Camera / view (screen size follows the window once rendering starts)
     es->game.cam.ppm      = 30.0f;
     es->game.cam.screen_w = 1280;
     es->game.cam.screen_h = 720;
@@ -25,6 +26,8 @@ void editor_state_defaults(EditorState *es) {
     es->game.goal.pos    = (Vec2){ 15.0f, 0.0f };
     es->game.goal.radius = 1.2f;
 
+    es->difficulty = 1;
+
     // Ship physics
     es->ship_density     = 1.0f;
     es->ship_restitution = 0.1f;
@@ -42,3 +45,18 @@ void editor_state_defaults(EditorState *es) {
     es->selected = SEL_NONE;
     es->hovered  = SEL_NONE;
 }
+
+void editor_delete_planet(EditorState *es, s32 idx) {
+    Game *g = &es->game;
+    if (idx < 0 || idx >= g->planet_count) return;
+
+    planet_texture_release(&g->planets[idx]);
+    for (s32 i = idx; i < g->planet_count - 1; i++)
+        g->planets[i] = g->planets[i + 1];
+    g->planet_count--;
+    g->planets[g->planet_count].tex_id = 0;
+
+    // Drop bit idx and shift the higher bits down with their planets
+    u32 below = es->planets_dirty & ((1u << idx) - 1);
+    es->planets_dirty = below | ((es->planets_dirty >> 1) & ~((1u << idx) - 1));
+}
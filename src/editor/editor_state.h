@@ -12,6 +12,7 @@ typedef struct {
 
     // Level metadata not stored in Game struct
     char name[64];
+    s32  difficulty;
     f32  ship_density;
     f32  ship_restitution;
     bool show_field_default;
@@ -25,7 +26,9 @@ typedef struct {
     Vec2 drag_offset;     // world-space offset from cursor to object center
     bool adding_planet;   // true = next click places a new planet
     char file_path[256];  // current file path for save/load
-    bool textures_dirty;  // true = need to regenerate planet textures
+    u32  planets_dirty;   // bit i = planet i needs a new texture
 } EditorState;
 
 void editor_state_defaults(EditorState *es);
+// Remove planet `idx`, freeing its texture and keeping dirty bits aligned
+void editor_delete_planet(EditorState *es, s32 idx);
@@ -6,12 +6,18 @@
 #include "cimgui.h"
 
 #include <SDL3/SDL.h>
+#include <stdio.h>
+#include <string.h>
 
 static const char *planet_type_names[] = {
     "Rocky", "Terrestrial", "Gas Giant", "Ice", "Volcanic"
 };
 
 void editor_ui(EditorState *es, SDL_Renderer *renderer) {
+    // Side panels hug the right edge of the window as first laid out
+    ImVec2 display = igGetIO_Nil()->DisplaySize;
+    f32 panel_x = display.x - 310;
+
     // ------------------------------------------------------------------
     // Toolbar
     // ------------------------------------------------------------------
@@ -29,12 +35,7 @@ void editor_ui(EditorState *es, SDL_Renderer *renderer) {
     bool can_delete = (es->selected >= 0 && es->selected < es->game.planet_count);
     if (!can_delete) igBeginDisabled(true);
     if (igButton("Delete Selected", (ImVec2){-1, 0}) && can_delete) {
-        Planet *p = &es->game.planets[es->selected];
-        if (p->texture) SDL_DestroyTexture(p->texture);
-        for (s32 i = es->selected; i < es->game.planet_count - 1; i++)
-            es->game.planets[i] = es->game.planets[i + 1];
-        es->game.planet_count--;
-        es->game.planets[es->game.planet_count].texture = NULL;
+        editor_delete_planet(es, es->selected);
         es->selected = SEL_NONE;
     }
     if (!can_delete) igEndDisabled();
@@ -58,16 +59,28 @@ void editor_ui(EditorState *es, SDL_Renderer *renderer) {
     if (igButton("Save", (ImVec2){90, 0}) && es->file_path[0])
         editor_save(es, es->file_path);
 
+    // Compiled copy next to the JSON: same stem, .gbl extension
+    if (igButton("Export .gbl", (ImVec2){190, 0}) && es->file_path[0]) {
+        char gbl[sizeof(es->file_path) + 4];
+        const char *dot   = strrchr(es->file_path, '.');
+        const char *slash = strrchr(es->file_path, '/');
+        int stem = (dot && (!slash || dot > slash)) ? (int)(dot - es->file_path)
+                                                     : (int)strlen(es->file_path);
+        snprintf(gbl, sizeof(gbl), "%.*s.gbl", stem, es->file_path);
+        editor_export_gbl(es, gbl);
+    }
+
     igEnd();
 
     // ------------------------------------------------------------------
     // Level Settings
     // ------------------------------------------------------------------
-    igSetNextWindowPos((ImVec2){1280 - 310, 10}, ImGuiCond_FirstUseEver, (ImVec2){0, 0});
+    igSetNextWindowPos((ImVec2){panel_x, 10}, ImGuiCond_FirstUseEver, (ImVec2){0, 0});
     igSetNextWindowSize((ImVec2){300, 520}, ImGuiCond_FirstUseEver);
     igBegin("Level Settings", NULL, 0);
 
     igInputText("Name", es->name, sizeof(es->name), 0, NULL, NULL);
+    igSliderInt("Difficulty", &es->difficulty, 1, 5, "%d", 0);
     igSeparator();
 
     igText("Bounds");
@@ -113,7 +126,7 @@ void editor_ui(EditorState *es, SDL_Renderer *renderer) {
     // ------------------------------------------------------------------
     // Properties (selected object)
     // ------------------------------------------------------------------
-    igSetNextWindowPos((ImVec2){1280 - 310, 540}, ImGuiCond_FirstUseEver, (ImVec2){0, 0});
+    igSetNextWindowPos((ImVec2){panel_x, display.y - 180}, ImGuiCond_FirstUseEver, (ImVec2){0, 0});
     igSetNextWindowSize((ImVec2){300, 170}, ImGuiCond_FirstUseEver);
     igBegin("Properties", NULL, 0);
 
@@ -132,17 +145,17 @@ void editor_ui(EditorState *es, SDL_Renderer *renderer) {
             p->type = (PlanetType)type_int;
             f32 base_speeds[] = { 2.0f, 3.0f, 8.0f, 1.5f, 5.0f };
             p->rotation_speed = base_speeds[p->type];
-            es->textures_dirty = true;
+            es->planets_dirty |= 1u << es->selected;
         }
 
         int seed_int = (int)p->seed;
         if (igDragInt("Seed", &seed_int, 1, 0, 99999, "%d", 0)) {
             p->seed = (u32)seed_int;
-            es->textures_dirty = true;
+            es->planets_dirty |= 1u << es->selected;
         }
 
         if (igButton("Regenerate Texture", (ImVec2){-1, 0}))
-            es->textures_dirty = true;
+            es->planets_dirty |= 1u << es->selected;
 
     } else if (es->selected == SEL_START) {
         igText("Start Position");
@@ -1,12 +1,18 @@
 #include "game/game.h"
-#include "data/json.h"
+#include "data/level.h"
+#include "data/replay.h"
 #include "physics/physics.h"
+#include "utils/profiler.h"
 #include <math.h>
+#include <string.h>
 
-bool game_init(Game *game, const char *level_path) {
+// Clean slate so a reload simulates exactly like a fresh run; the level
+// fills in the rest
+static void game_reset(Game *game) {
+    memset(game, 0, sizeof(*game));
     game->state = GAME_STATE_AIM;
 
-    // Screen defaults
+    // Screen defaults; the renderer sizes the camera to the window each frame
     game->cam.cam_x    = 0.0f;
     game->cam.cam_y    = 0.0f;
     game->cam.screen_w = 1280;
@@ -15,11 +21,10 @@ bool game_init(Game *game, const char *level_path) {
     // Fleet defaults (before JSON overrides)
     game->fleet_count    = 1;
     game->required_ships = 1;
+}
 
-    // Load level data from JSON
-    if (!json_load(level_path, game))
-        return false;
-
+// Fleet formation and the Box2D world, once the level is applied
+static void game_start(Game *game) {
     // Initialize fleet ships in circular formation around leader
     Vec2 start_pos = game->ships[0].pos;
     f32  ship_radius = game->ships[0].radius;
@@ -47,10 +52,62 @@ bool game_init(Game *game, const char *level_path) {
 
     // Create Box2D world and bodies
     physics_init(game);
+}
+
+bool game_init(Game *game, const char *level_path) {
+    game_reset(game);
+    PROF_BEGIN("level_load");
 
+    // Load level data (compiled .gbl or JSON)
+    if (!level_load(level_path, game)) {
+        PROF_END();
+        return false;
+    }
+    game_start(game);
+
+    PROF_END();
     return true;
 }
 
+void game_init_desc(Game *game, const LevelDesc *desc) {
+    game_reset(game);
+    PROF_BEGIN("level_build");
+    level_desc_apply(desc, game);
+    game_start(game);
+    PROF_END();
+}
+
+void game_snapshot(const Game *game, Game *out) {
+    *out = *game;
+    out->phys   = (PhysState){0};
+    out->replay = NULL;
+}
+
+void game_restart(Game *game, const Game *initial) {
+    PROF_BEGIN("game_restart");
+    physics_shutdown(game);
+
+    // A world that has been stepped keeps contacts, warm-start impulses and
+    // its broadphase tree order, so moving the bodies back would not replay
+    // like a fresh load. Building a new world from memory is cheap.
+    u32 tex_id[MAX_PLANETS];
+    for (s32 i = 0; i < game->planet_count; i++)
+        tex_id[i] = game->planets[i].tex_id;
+    s32 screen_w = game->cam.screen_w;
+    s32 screen_h = game->cam.screen_h;
+    struct Replay *replay = game->replay;
+
+    *game = *initial;
+    for (s32 i = 0; i < game->planet_count; i++)
+        game->planets[i].tex_id = tex_id[i];
+    game->cam.screen_w = screen_w;
+    game->cam.screen_h = screen_h;
+    game->replay       = replay;
+
+    physics_init(game);
+    PROF_END();
+}
+
 void game_aim_start(Game *game, f32 screen_x, f32 screen_y) {
     if (game->state != GAME_STATE_AIM) return;
 
@@ -93,12 +150,21 @@ void game_aim_release(Game *game, f32 screen_x, f32 screen_y) {
         dir.y / len * speed,
     };
 
+    game_launch(game, vel);
+}
+
+void game_launch(Game *game, Vec2 vel) {
+    if (game->state != GAME_STATE_AIM) return;
+
     // Set velocity on the leader Box2D body (followers follow via springs)
     physics_launch(game, vel);
 
     game->ships[0].vel = vel;
-    game->ships[0].angle = atan2f(dir.y, dir.x);
+    game->ships[0].angle = atan2f(vel.y, vel.x);
     game->state = GAME_STATE_PLAYING;
+
+    if (game->replay)
+        replay_record_input(game->replay, REPLAY_INPUT_LAUNCH, game->phys.substep, vel);
 }
 
 void game_update(Game *game, float dt) {
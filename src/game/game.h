@@ -3,8 +3,11 @@
 #include <math.h>
 #include <box2d/box2d.h>
 #include "utils/q_util.h"
+#include "game/trail.h"
 
 struct SDL_Texture;
+struct Replay;
+struct LevelDesc;
 
 #define MAX_PLANETS 16
 #define MAX_FLEET   10
@@ -38,7 +41,7 @@ typedef struct {
     f32  eps;             // softening parameter
     u32  seed;            // visual seed (derived from position if not in JSON)
     PlanetType type;      // determines color palette
-    struct SDL_Texture *texture;  // generated at level load, NULL initially
+    u32  tex_id;          // planet atlas entry, 0 until generated
     f32  rotation_speed;  // degrees/sec (derived from type)
     f32  rotation_angle;  // current angle, updated in game_update
 } Planet;
@@ -57,6 +60,22 @@ typedef struct {
     f32  radius;
 } Goal;
 
+// Things the physics step reports to the frontend (effects, sound)
+typedef enum {
+    GAME_EVENT_SHIP_CRASHED,   // hit a planet
+    GAME_EVENT_SHIP_LOST,      // left the level bounds
+    GAME_EVENT_SHIP_ARRIVED,   // entered the goal
+} GameEventType;
+
+typedef struct {
+    GameEventType type;
+    s32  ship;
+    Vec2 pos;
+    Vec2 vel;
+} GameEvent;
+
+#define MAX_GAME_EVENTS 32
+
 // World-to-screen conversion
 typedef struct {
     f32 ppm;       // pixels per meter
@@ -78,12 +97,24 @@ typedef struct {
     b2BodyId   goal_body;
     b2BodyId   planet_bodies[MAX_PLANETS];
     f32        accumulator;                // fixed-timestep accumulator
+    u32        substep;                    // fixed substeps run since init
+
+    // Per-frame diagnostics (reset at the top of every physics_step)
+    b2Profile  frame_profile;              // Box2D stage times (ms), summed over substeps
+    b2Counters counters;                   // Box2D counters after the last substep
+    f32        frame_force_ms;             // our gravity/tether/separation time
+    s32        frame_substeps;
+
+    // Events raised during the last physics_step (also reset each call)
+    GameEvent  events[MAX_GAME_EVENTS];
+    s32        event_count;
 } PhysState;
 
 typedef struct {
     GameState state;
     Camera    cam;
     Ship      ships[MAX_FLEET];        // ships[0] = leader
+    Trail     trails[MAX_FLEET];       // per-ship motion trails (render only)
     s32       fleet_count;             // total ships (from JSON, default 1)
     s32       required_ships;          // ships needed at goal to win (default 1)
     s32       alive_count;             // ships not destroyed
@@ -97,14 +128,25 @@ typedef struct {
     AimState  aim;
     PhysState phys;
     bool      show_field;
+    struct Replay *replay;             // optional input/checksum recorder
 } Game;
 
 bool game_init(Game *game, const char *level_path);
+// Same from a level already read and parsed (data/level.h); no file I/O
+void game_init_desc(Game *game, const struct LevelDesc *desc);
+// Copy of a freshly initialised game for game_restart; owns no Box2D world
+void game_snapshot(const Game *game, Game *out);
+// Back to `initial` with a new world built from it: no file I/O or parsing,
+// and planet textures, the window size and game->replay are kept. Runs
+// exactly like a fresh game_init of the same level.
+void game_restart(Game *game, const Game *initial);
 void game_update(Game *game, float dt);
 void game_shutdown(Game *game);
 void game_aim_start(Game *game, f32 screen_x, f32 screen_y);
 void game_aim_move(Game *game, f32 screen_x, f32 screen_y);
 void game_aim_release(Game *game, f32 screen_x, f32 screen_y);
+// Launch the fleet leader (the only run input); recorded into game->replay
+void game_launch(Game *game, Vec2 vel);
 
 // Coordinate helpers
 static inline f32 world_to_screen_x(const Camera *c, f32 wx) {
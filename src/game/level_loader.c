@@ -0,0 +1,320 @@
+#include "game/level_loader.h"
+#include "data/fs.h"
+#include "data/level.h"
+#include "data/level_pack.h"
+#include "utils/profiler.h"
+#include <SDL3/SDL.h>
+#include <stdio.h>
+#include <string.h>
+
+typedef enum {
+    SLOT_FREE,
+    SLOT_QUEUED,
+    SLOT_FETCHING,     // no thread: async read in flight
+    SLOT_FETCHED,      // no thread: bytes in, build when wanted
+    SLOT_BUILDING,     // on the loader thread
+    SLOT_READY,
+    SLOT_FAILED,
+} SlotState;
+
+typedef struct {
+    Game   game;
+    Replay replay;
+} BuiltLevel;
+
+typedef struct {
+    char          path[REPLAY_MAX_PATH];
+    SlotState     state;
+    bool          urgent;
+    u32           order;       // request sequence; oldest goes first
+    void         *data;        // level bytes while FETCHING/FETCHED
+    size_t        size;
+    s32           entry;       // pack entry, for the hash check
+    volatile s32  io_status;   // fs_read_range_async
+    BuiltLevel   *built;       // READY
+} LoadSlot;
+
+static SDL_Thread    *loader_thread;
+static SDL_Mutex     *loader_lock;
+static SDL_Condition *loader_wake;     // a slot was queued, or quit
+static SDL_Condition *loader_done;     // a build finished
+static bool           loader_quit;
+static u32            loader_order;
+static LoadSlot       slots[LEVEL_LOADER_SLOTS];
+
+// Parse and build; the replay hash covers the same bytes the level came from
+static BuiltLevel *build_level(const char *path, const void *data, size_t size) {
+    LevelDesc scratch;
+    const LevelDesc *desc = level_parse(path, data, size, &scratch);
+    if (!desc) return NULL;
+    BuiltLevel *b = SDL_malloc(sizeof(*b));
+    if (!b) return NULL;
+    replay_begin_data(&b->replay, path, data, size);
+    game_init_desc(&b->game, desc);
+    return b;
+}
+
+// Read with level_read (in place for a mapped pack), then build
+static BuiltLevel *read_and_build(const char *path) {
+    PROF_BEGIN("level_read");
+    LevelBytes bytes;
+    bool ok = level_read(path, &bytes);
+    PROF_END();
+    if (!ok) {
+        SDL_Log("level_loader: failed to read '%s'", path);
+        return NULL;
+    }
+    BuiltLevel *b = build_level(path, bytes.data, bytes.size);
+    level_bytes_free(&bytes);
+    return b;
+}
+
+static void slot_clear(LoadSlot *s) {
+    if (s->built) {
+        game_shutdown(&s->built->game);
+        SDL_free(s->built);
+    }
+    SDL_free(s->data);
+    *s = (LoadSlot){0};
+}
+
+static LoadSlot *slot_find(const char *path) {
+    for (s32 i = 0; i < LEVEL_LOADER_SLOTS; i++)
+        if (slots[i].state != SLOT_FREE && strcmp(slots[i].path, path) == 0)
+            return &slots[i];
+    return NULL;
+}
+
+static LevelLoadStatus slot_status(const LoadSlot *s) {
+    if (!s) return LEVEL_LOAD_NONE;
+    switch (s->state) {
+    case SLOT_FREE:   return LEVEL_LOAD_NONE;
+    case SLOT_READY:  return LEVEL_LOAD_READY;
+    case SLOT_FAILED: return LEVEL_LOAD_FAILED;
+    default:          return LEVEL_LOAD_PENDING;
+    }
+}
+
+// A free slot, else the oldest one nobody is waiting on and nothing is
+// writing into (a build or an async read in flight)
+static LoadSlot *slot_claim(void) {
+    LoadSlot *best = NULL;
+    for (s32 i = 0; i < LEVEL_LOADER_SLOTS; i++) {
+        LoadSlot *s = &slots[i];
+        if (s->state == SLOT_FREE) return s;
+        if (s->urgent || s->state == SLOT_BUILDING || s->state == SLOT_FETCHING)
+            continue;
+        if (!best || s->order < best->order) best = s;
+    }
+    if (best) slot_clear(best);
+    return best;
+}
+
+// Next slot to work on in `state`: the urgent one, else the oldest
+static LoadSlot *slot_next(SlotState state) {
+    LoadSlot *best = NULL;
+    for (s32 i = 0; i < LEVEL_LOADER_SLOTS; i++) {
+        LoadSlot *s = &slots[i];
+        if (s->state != state) continue;
+        if (s->urgent) return s;
+        if (!best || s->order < best->order) best = s;
+    }
+    return best;
+}
+
+static int SDLCALL loader_worker(void *data) {
+    (void)data;
+    SDL_LockMutex(loader_lock);
+    for (;;) {
+        LoadSlot *s = NULL;
+        while (!loader_quit && !(s = slot_next(SLOT_QUEUED)))
+            SDL_WaitCondition(loader_wake, loader_lock);
+        if (loader_quit) break;
+
+        // A building slot is never claimed or cleared, so it is ours until
+        // the result is posted
+        char path[REPLAY_MAX_PATH];
+        snprintf(path, sizeof(path), "%s", s->path);
+        s->state = SLOT_BUILDING;
+        SDL_UnlockMutex(loader_lock);
+
+        BuiltLevel *b = read_and_build(path);
+
+        SDL_LockMutex(loader_lock);
+        s->built = b;
+        s->state = b ? SLOT_READY : SLOT_FAILED;
+        SDL_BroadcastCondition(loader_done);
+    }
+    SDL_UnlockMutex(loader_lock);
+    return 0;
+}
+
+void level_loader_init(void) {
+    loader_lock = SDL_CreateMutex();
+    loader_wake = SDL_CreateCondition();
+    loader_done = SDL_CreateCondition();
+    if (loader_lock && loader_wake && loader_done)
+        loader_thread = SDL_CreateThread(loader_worker, "level_loader", NULL);
+    if (!loader_thread)
+        SDL_Log("level_loader: no loader thread, building on the main thread");
+}
+
+void level_loader_shutdown(void) {
+    if (loader_thread) {
+        SDL_LockMutex(loader_lock);
+        loader_quit = true;
+        SDL_SignalCondition(loader_wake);
+        SDL_UnlockMutex(loader_lock);
+        SDL_WaitThread(loader_thread, NULL);
+    }
+    for (s32 i = 0; i < LEVEL_LOADER_SLOTS; i++) {
+        // The browser may still write into an unfinished read; leave it be
+        if (slots[i].state != SLOT_FETCHING)
+            slot_clear(&slots[i]);
+    }
+    if (loader_done) SDL_DestroyCondition(loader_done);
+    if (loader_wake) SDL_DestroyCondition(loader_wake);
+    if (loader_lock) SDL_DestroyMutex(loader_lock);
+
+    loader_thread = NULL;
+    loader_lock   = NULL;
+    loader_wake   = NULL;
+    loader_done   = NULL;
+    loader_quit   = false;
+    loader_order  = 0;
+}
+
+void level_loader_request(const char *path, bool urgent) {
+    SDL_LockMutex(loader_lock);
+    if (urgent)
+        for (s32 i = 0; i < LEVEL_LOADER_SLOTS; i++)
+            slots[i].urgent = false;
+
+    LoadSlot *s = slot_find(path);
+    if (s && s->state == SLOT_FAILED) {
+        slot_clear(s);   // try again
+        s = NULL;
+    }
+    if (!s && (s = slot_claim())) {
+        snprintf(s->path, sizeof(s->path), "%s", path);
+        s->state = SLOT_QUEUED;
+        s->order = ++loader_order;
+        SDL_SignalCondition(loader_wake);
+    }
+    if (s && urgent)
+        s->urgent = true;
+    else if (!s)
+        SDL_Log("level_loader: no free slot for '%s'", path);
+    SDL_UnlockMutex(loader_lock);
+}
+
+LevelLoadStatus level_loader_status(const char *path) {
+    SDL_LockMutex(loader_lock);
+    LevelLoadStatus status = slot_status(slot_find(path));
+    SDL_UnlockMutex(loader_lock);
+    return status;
+}
+
+// No thread: start reading a queued slot. Pack entries are fetched
+// asynchronously; loose files are read in place, and only once wanted.
+static void fetch_start(LoadSlot *s) {
+    char pack_path[256];
+    const char *id;
+    if (!level_pack_split_ref(s->path, pack_path, sizeof(pack_path), &id)) {
+        if (!s->urgent) return;
+        LevelBytes bytes;
+        bool ok = level_read(s->path, &bytes);
+        s->data  = bytes.owned;   // a loose file is always a heap copy
+        s->size  = bytes.size;
+        s->state = ok ? SLOT_FETCHED : SLOT_FAILED;
+        if (!ok) SDL_Log("level_loader: failed to read '%s'", s->path);
+        return;
+    }
+
+    const LevelPack *pack = level_pack_get(pack_path);
+    s->entry = pack ? level_pack_find(pack, id) : -1;
+    if (s->entry < 0) {
+        SDL_Log("level_loader: no level '%s' in '%s'", id, pack_path);
+        s->state = SLOT_FAILED;
+        return;
+    }
+    const LevelPackEntry *e = &pack->entries[s->entry];
+    s->size = e->payload_size;
+    s->data = SDL_malloc(s->size);
+    if (!s->data) {
+        s->state = SLOT_FAILED;
+        return;
+    }
+    s->state = SLOT_FETCHING;
+    fs_read_range_async(pack->path, e->payload_offset, s->size, s->data, &s->io_status);
+}
+
+// No thread: a finished async read becomes FETCHED once its hash checks out
+static void fetch_poll(LoadSlot *s) {
+    if (s->io_status == FS_READ_PENDING) return;
+
+    char pack_path[256];
+    const char *id;
+    level_pack_split_ref(s->path, pack_path, sizeof(pack_path), &id);
+    const LevelPack *pack = level_pack_get(pack_path);
+    if (s->io_status == FS_READ_DONE && pack && level_pack_verify(pack, s->entry, s->data)) {
+        s->state = SLOT_FETCHED;
+        return;
+    }
+    if (s->io_status == FS_READ_FAILED)
+        SDL_Log("level_loader: failed to read '%s'", s->path);
+    SDL_free(s->data);
+    s->data  = NULL;
+    s->state = SLOT_FAILED;
+}
+
+static void build_fetched(LoadSlot *s) {
+    s->built = build_level(s->path, s->data, s->size);
+    SDL_free(s->data);
+    s->data  = NULL;
+    s->state = s->built ? SLOT_READY : SLOT_FAILED;
+}
+
+void level_loader_poll(void) {
+    if (loader_thread) return;
+
+    for (s32 i = 0; i < LEVEL_LOADER_SLOTS; i++) {
+        if (slots[i].state == SLOT_QUEUED)   fetch_start(&slots[i]);
+        if (slots[i].state == SLOT_FETCHING) fetch_poll(&slots[i]);
+    }
+    // Build only what the player is waiting for, one level per frame
+    LoadSlot *s = slot_next(SLOT_FETCHED);
+    if (s && s->urgent) build_fetched(s);
+}
+
+LevelLoadStatus level_loader_wait(const char *path) {
+    SDL_LockMutex(loader_lock);
+    LoadSlot *s = slot_find(path);
+    if (!loader_thread && s && s->state == SLOT_QUEUED) {
+        s->built = read_and_build(s->path);
+        s->state = s->built ? SLOT_READY : SLOT_FAILED;
+    }
+    if (!loader_thread && s && s->state == SLOT_FETCHED)
+        build_fetched(s);
+    while (loader_thread && slot_status(s) == LEVEL_LOAD_PENDING)
+        SDL_WaitCondition(loader_done, loader_lock);
+    LevelLoadStatus status = slot_status(s);
+    SDL_UnlockMutex(loader_lock);
+    return status;
+}
+
+LevelLoadStatus level_loader_take(const char *path, Game *game, Replay *replay) {
+    SDL_LockMutex(loader_lock);
+    LoadSlot *s = slot_find(path);
+    LevelLoadStatus status = slot_status(s);
+    if (status == LEVEL_LOAD_READY) {
+        *game   = s->built->game;
+        *replay = s->built->replay;
+        SDL_free(s->built);
+        s->built = NULL;
+    }
+    if (status == LEVEL_LOAD_READY || status == LEVEL_LOAD_FAILED)
+        slot_clear(s);
+    SDL_UnlockMutex(loader_lock);
+    return status;
+}
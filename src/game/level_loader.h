@@ -0,0 +1,44 @@
+#pragma once
+#include <stdbool.h>
+#include "game/game.h"
+#include "data/replay.h"
+
+// Builds levels away from the frame. Reading the bytes, parsing them,
+// creating the Box2D world and hashing them for the replay all run on a
+// loader thread; the main thread only swaps the finished Game in.
+// Requests are keyed by level path ("<pack>#<id>" or a file), and a level
+// that is already queued, in flight or built is not started again, so a
+// prefetched level costs nothing extra when it is picked.
+//
+// Without threads (single-threaded web build) pack reads still go out as
+// async range requests. level_loader_poll then builds the level being
+// waited on, on the main thread once its bytes are in; prefetches are only
+// fetched.
+
+#define LEVEL_LOADER_SLOTS 4   // levels queued, in flight or built at once
+
+typedef enum {
+    LEVEL_LOAD_NONE,       // never requested, or already taken
+    LEVEL_LOAD_PENDING,
+    LEVEL_LOAD_READY,
+    LEVEL_LOAD_FAILED,
+} LevelLoadStatus;
+
+void level_loader_init(void);
+// Stop the thread and free every level nobody took
+void level_loader_shutdown(void);
+
+// Queue `path`. An urgent request (the player is waiting for it) goes
+// ahead of prefetches and demotes any earlier urgent one.
+void level_loader_request(const char *path, bool urgent);
+LevelLoadStatus level_loader_status(const char *path);
+// Block until `path` is built or has failed; for startup. Without a thread
+// the level is read and built right here, unless an async read is already
+// in flight (then it stays PENDING).
+LevelLoadStatus level_loader_wait(const char *path);
+// Move a READY level into `game` and `replay` and free its slot (the
+// caller shuts the old game down first; game->replay comes back NULL).
+// A FAILED request is dropped. Returns the status it had.
+LevelLoadStatus level_loader_take(const char *path, Game *game, Replay *replay);
+// Advance async reads and main-thread builds; call once a frame
+void level_loader_poll(void);
@@ -0,0 +1,35 @@
+#include "game/trail.h"
+#include <math.h>
+
+static void trail_push(Trail *t, TrailPoint p) {
+    t->points[t->head] = p;
+    t->head = (t->head + 1) % TRAIL_CAPACITY;
+    if (t->count < TRAIL_CAPACITY) t->count++;
+}
+
+void trail_sample(Trail *t, f32 x, f32 y) {
+    TrailPoint p = { x, y };
+    if (t->count == 0) {
+        trail_push(t, p);
+        t->tip = p;
+        return;
+    }
+
+    // Line from the last committed point through the tip
+    TrailPoint last = t->points[(t->head + TRAIL_CAPACITY - 1) % TRAIL_CAPACITY];
+    f32 dx = t->tip.x - last.x;
+    f32 dy = t->tip.y - last.y;
+    f32 len = sqrtf(dx * dx + dy * dy);
+
+    if (len > 1e-4f) {
+        f32 px = x - last.x;
+        f32 py = y - last.y;
+        // Perpendicular distance of the new sample from that line, and how
+        // far along it the sample lies
+        f32 off   = fabsf(dx * py - dy * px) / len;
+        f32 along = (dx * px + dy * py) / len;
+        if (off > TRAIL_TOLERANCE || along > TRAIL_MAX_SEGMENT || along < 0.0f)
+            trail_push(t, t->tip);
+    }
+    t->tip = p;
+}
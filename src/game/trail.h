@@ -0,0 +1,44 @@
+#pragma once
+#include <stdbool.h>
+#include "utils/q_util.h"
+
+// Motion trail for one ship: a fixed ring of world-space points, so
+// recording never allocates and the oldest points fall off once it is full.
+//
+// Samples arrive every physics substep but are decimated as they come in.
+// The newest sample is kept as a floating tip; it is committed to the ring
+// only once the path bends away from the line through the last committed
+// point by more than TRAIL_TOLERANCE, or that segment reaches
+// TRAIL_MAX_SEGMENT. Straight coasting therefore stores one point every
+// few meters while tight turns around a planet keep their shape.
+//
+// A zeroed Trail is empty; trails are cleared along with the Game.
+
+#define TRAIL_CAPACITY    128     // committed points per ship
+#define TRAIL_TOLERANCE   0.01f   // meters of deviation before committing
+#define TRAIL_MAX_SEGMENT 3.0f    // meters between points on a straight path
+
+typedef struct {
+    f32 x, y;
+} TrailPoint;
+
+typedef struct {
+    TrailPoint points[TRAIL_CAPACITY];
+    s32        head;     // next slot to write
+    s32        count;    // committed points
+    TrailPoint tip;      // latest sample, valid when count > 0
+} Trail;
+
+void trail_sample(Trail *t, f32 x, f32 y);
+
+// Points including the tip, oldest first
+static inline s32 trail_length(const Trail *t) {
+    return t->count > 0 ? t->count + 1 : 0;
+}
+
+static inline TrailPoint trail_point(const Trail *t, s32 i) {
+    if (i == t->count) return t->tip;
+    s32 slot = t->head - t->count + i;
+    if (slot < 0) slot += TRAIL_CAPACITY;
+    return t->points[slot];
+}
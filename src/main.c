@@ -7,27 +7,42 @@
 #include "cimgui.h"
 #include "imgui_sdl3.h"
 #include "utils/q_util.h"
+#include "utils/profiler.h"
+#include "utils/mem_track.h"
+#include "utils/jobs.h"
 
 #include "game/game.h"
+#include "game/level_loader.h"
+#include "data/replay.h"
+#include "data/level_pack.h"
+#include "data/tex_cache.h"
 #include "render/render.h"
 #include "render/planet_gen.h"
 
+#include <float.h>
+
+// Initial window size in points; the window is resizable
 #define WINDOW_W 1280
 #define WINDOW_H 720
 
-#define NUM_LEVELS 3
+// Every shipped level; built from assets/levels/*.json by the level_pack target
+#define LEVEL_PACK_PATH "assets/levels.gbp"
 
-static const char *level_paths[NUM_LEVELS] = {
-    "assets/levels/slingshot_01.json",
-    "assets/levels/gauntlet_02.json",
-    "assets/levels/quad_03.json",
+// Level transition: fade out while the next level loads, swap it in under
+// full cover, fade back in (seconds)
+#define LEVEL_FADE_OUT 0.12f
+#define LEVEL_FADE_IN  0.25f
 
-};
+// How the gravity field overlay is drawn
+typedef enum {
+    FIELD_VIEW_ARROWS,
+    FIELD_VIEW_ACCEL,       // |a| heatmap
+    FIELD_VIEW_POTENTIAL,   // potential heatmap
+    FIELD_VIEW_COUNT,
+} FieldView;
 
-static const char *level_names[NUM_LEVELS] = {
-    "Slingshot 01",
-    "Gauntlet 02",
-    "QuadRun 03",
+static const char *field_view_names[FIELD_VIEW_COUNT] = {
+    "Arrows", "Accel heatmap", "Potential heatmap",
 };
 
 // Frame timing breakdown (smoothed, in ms)
@@ -39,27 +54,328 @@ typedef struct {
     f32 total;
 } FrameTiming;
 
+// Rolling per-frame physics breakdown for the "Physics internals" graphs
+#define PHYS_HIST_LEN 120
+
+typedef struct {
+    f32 step[PHYS_HIST_LEN];     // Box2D b2World_Step total
+    f32 collide[PHYS_HIST_LEN];  // narrowphase
+    f32 solve[PHYS_HIST_LEN];    // constraint solver
+    f32 force[PHYS_HIST_LEN];    // our gravity/tether/separation forces
+    s32 head;
+} PhysHistory;
+
 // AppState
 typedef struct {
   SDL_Window *window;
   SDL_Renderer *renderer;
-  SDL_Texture *texture;
+  SDL_Texture *texture;  // streaming; gravity heatmap, sized to the screen
   u64 last_counter;
   Game game;
+  Game initial;         // current level as loaded, for R
+  const LevelPack *pack;  // index only; levels are read when picked
   int level_idx;
+  char level_ref[REPLAY_MAX_PATH];  // "<pack>#<id>" of the loaded level
+  char pending_ref[REPLAY_MAX_PATH];  // level being loaded, "" for none
+  int pending_idx;
+  f32 fade;             // transition cover over the world, 0..1
+  SDL_Texture *thumb;   // preview of the level highlighted in the menu
+  int thumb_idx;        // entry shown in `thumb`, -1 for none
   f32 fps_smooth;  // exponentially smoothed FPS
   bool show_stars;
+  int field_view;       // FieldView
+  int heatmap_div;      // heatmap resolution divisor (1 = full)
   FrameTiming timing;
+  PhysHistory phys_hist;
+  Replay replay;        // current attempt (inputs + checksums)
+  bool replay_saved;
+  bool dynamic_res;     // let render_scale adapt to the frame budget
+  f32 fixed_res;        // scale used while dynamic_res is off
 } AppState;
 
 static inline f32 elapsed_ms(u64 start, u64 freq) {
     return (f32)(SDL_GetPerformanceCounter() - start) / (f32)freq * 1000.0f;
 }
 
+// Write the current attempt to replays/ once it ends or is abandoned
+static void replay_flush(AppState *state) {
+    Replay *r = &state->replay;
+    if (state->replay_saved || r->input_count == 0) return;
+    state->replay_saved = true;
+    replay_finish(r, state->game.state);
+
+#ifndef __EMSCRIPTEN__
+    // Level id, or the file stem for a loose file:
+    // "assets/levels.gbp#quad_03" or "assets/levels/quad_03.json" -> "quad_03"
+    const char *stem = r->level_path;
+    for (const char *c = r->level_path; *c; c++)
+        if (*c == '/' || *c == '\\' || *c == '#') stem = c + 1;
+    int stem_len = 0;
+    while (stem[stem_len] && stem[stem_len] != '.') stem_len++;
+
+    SDL_Time now = 0;
+    SDL_GetCurrentTime(&now);
+
+    char path[256];
+    snprintf(path, sizeof(path), "replays/%.*s_%lld.gbr", stem_len, stem, (long long)now);
+    SDL_CreateDirectory("replays");
+    if (!replay_save(r, path))
+        SDL_Log("replay_flush: failed to write '%s'", path);
+#endif
+}
+
+// (Re)create the heatmap texture when the screen size changes
+static bool ensure_heatmap_texture(AppState *state) {
+    const Camera *cam = &state->game.cam;
+    f32 w = 0, h = 0;
+    if (state->texture) {
+        SDL_GetTextureSize(state->texture, &w, &h);
+        if ((s32)w == cam->screen_w && (s32)h == cam->screen_h)
+            return true;
+        SDL_DestroyTexture(state->texture);
+    }
+
+    state->texture = SDL_CreateTexture(state->renderer, SDL_PIXELFORMAT_ABGR8888,
+                                       SDL_TEXTUREACCESS_STREAMING,
+                                       cam->screen_w, cam->screen_h);
+    heatmap_invalidate();
+    if (!state->texture) {
+        SDL_Log("SDL_CreateTexture failed: %s", SDL_GetError());
+        return false;
+    }
+    SDL_SetTextureScaleMode(state->texture, SDL_SCALEMODE_NEAREST);
+    return true;
+}
+
+// Swap the built pending level in for the current one and start recording
+// a new attempt; then prefetch the level after it
+static void swap_level(AppState *state) {
+    replay_flush(state);
+    planet_textures_destroy(&state->game);
+    game_shutdown(&state->game);
+    particles_clear();
+
+    // Built levels carry a default camera; keep it sized to the window
+    s32 screen_w = state->game.cam.screen_w;
+    s32 screen_h = state->game.cam.screen_h;
+
+    level_loader_take(state->pending_ref, &state->game, &state->replay);
+    if (screen_w > 0 && screen_h > 0) {
+        state->game.cam.screen_w = screen_w;
+        state->game.cam.screen_h = screen_h;
+    }
+    game_snapshot(&state->game, &state->initial);
+    planet_textures_generate(state->renderer, &state->game);
+
+    state->replay_saved = false;
+    state->game.replay  = &state->replay;
+    state->level_idx    = state->pending_idx;
+    snprintf(state->level_ref, sizeof(state->level_ref), "%s", state->pending_ref);
+    state->pending_ref[0] = '\0';
+
+    if (state->level_idx + 1 < state->pack->count) {
+        char next[REPLAY_MAX_PATH];
+        level_pack_ref(state->pack, state->level_idx + 1, next, sizeof(next));
+        level_loader_request(next, false);
+    }
+}
+
+// Retry: back to the loaded state of the current level from the snapshot,
+// keeping its textures; nothing is read or parsed
+static void restart_level(AppState *state) {
+    replay_flush(state);
+    particles_clear();
+    game_restart(&state->game, &state->initial);
+    replay_restart(&state->replay);
+    state->replay_saved = false;
+}
+
+// Switch to pack entry `idx`; poll_level swaps it in once it is built and
+// the screen is covered
+static void request_level(AppState *state, int idx) {
+    state->pending_idx = idx;
+    level_pack_ref(state->pack, idx, state->pending_ref, sizeof(state->pending_ref));
+    level_loader_request(state->pending_ref, true);
+}
+
+// Once a frame, before the simulation: run the transition and swap in the
+// pending level when it is ready
+static void poll_level(AppState *state, f32 dt) {
+    level_loader_poll();
+    if (!state->pending_ref[0]) {
+        state->fade = MAX(state->fade - dt / LEVEL_FADE_IN, 0.0f);
+        return;
+    }
+    state->fade = MIN(state->fade + dt / LEVEL_FADE_OUT, 1.0f);
+
+    LevelLoadStatus status = level_loader_status(state->pending_ref);
+    if (status == LEVEL_LOAD_READY && state->fade >= 1.0f) {
+        swap_level(state);
+    } else if (status == LEVEL_LOAD_FAILED || status == LEVEL_LOAD_NONE) {
+        // Keep playing the current level
+        SDL_Log("Failed to load '%s'", state->pending_ref);
+        level_loader_take(state->pending_ref, &state->game, &state->replay);
+        state->pending_ref[0] = '\0';
+    }
+}
+
+// Cover the world (not the UI) during a transition; name the level when
+// the wait outlasts the fade
+static void draw_transition(const AppState *state) {
+    if (state->fade <= 0.0f) return;
+    ImGuiViewport *vp = igGetMainViewport();
+    ImDrawList *dl = igGetBackgroundDrawList(vp);
+    ImVec2 max = { vp->Pos.x + vp->Size.x, vp->Pos.y + vp->Size.y };
+    u32 alpha = (u32)(state->fade * 255.0f);
+    ImDrawList_AddRectFilled(dl, vp->Pos, max, (alpha << 24) | (18 << 16) | (10 << 8) | 10, 0.0f, 0);
+
+    if (state->pending_ref[0] && state->fade >= 1.0f) {
+        char label[96];
+        snprintf(label, sizeof(label), "Loading %s...", state->pack->entries[state->pending_idx].name);
+        ImVec2 size = igCalcTextSize(label, NULL, false, -1.0f);
+        ImVec2 pos = { vp->Pos.x + (vp->Size.x - size.x) * 0.5f,
+                       vp->Pos.y + (vp->Size.y - size.y) * 0.5f };
+        ImDrawList_AddText_Vec2(dl, pos, 0xFFB4B4B4, label, NULL);
+    }
+}
+
+// Show entry `idx`'s thumbnail in state->thumb; read from the pack on change
+static bool update_level_thumb(AppState *state, int idx) {
+    if (state->thumb_idx == idx) return state->thumb != NULL;
+    state->thumb_idx = idx;
+
+    u8 rgba[LEVEL_THUMB_SIZE];
+    if (!level_pack_read_thumb(state->pack, idx, rgba)) return false;
+    if (!state->thumb) {
+        state->thumb = SDL_CreateTexture(state->renderer, SDL_PIXELFORMAT_ABGR8888,
+                                         SDL_TEXTUREACCESS_STATIC,
+                                         LEVEL_THUMB_W, LEVEL_THUMB_H);
+        if (!state->thumb) return false;
+        SDL_SetTextureScaleMode(state->thumb, SDL_SCALEMODE_NEAREST);
+    }
+    return SDL_UpdateTexture(state->thumb, NULL, rgba, LEVEL_THUMB_W * 4);
+}
+
+// Level combo fed from the pack index. Only visible rows are submitted, so
+// long packs cost nothing while the list is closed or scrolled.
+static void draw_level_select(AppState *state) {
+    const LevelPack *pack = state->pack;
+    const LevelPackEntry *current = &pack->entries[state->level_idx];
+    int picked = state->level_idx;
+
+    if (igBeginCombo("Level", current->name, 0)) {
+        ImGuiListClipper *clipper = ImGuiListClipper_ImGuiListClipper();
+        ImGuiListClipper_Begin(clipper, pack->count, -1.0f);
+        ImGuiListClipper_IncludeItemByIndex(clipper, state->level_idx);
+        while (ImGuiListClipper_Step(clipper)) {
+            for (int i = clipper->DisplayStart; i < clipper->DisplayEnd; i++) {
+                const LevelPackEntry *e = &pack->entries[i];
+                char label[LEVEL_NAME_MAX + 32];
+                snprintf(label, sizeof(label), "%s  (%d)##%d", e->name, e->difficulty, i);
+                bool selected = i == state->level_idx;
+                if (igSelectable_Bool(label, selected, 0, (ImVec2){0, 0}))
+                    picked = i;
+                if (selected) igSetItemDefaultFocus();
+            }
+        }
+        ImGuiListClipper_destroy(clipper);
+        igEndCombo();
+    }
+
+    if (picked != state->level_idx)
+        request_level(state, picked);
+
+    igTextDisabled("Difficulty %d  |  %d/%d", pack->entries[state->level_idx].difficulty,
+                   state->level_idx + 1, pack->count);
+    if (update_level_thumb(state, state->level_idx)) {
+        igImage((ImTextureRef_c){ ._TexID = (ImTextureID)(uintptr_t)state->thumb },
+                (ImVec2){LEVEL_THUMB_W * 2, LEVEL_THUMB_H * 2},
+                (ImVec2){0, 0}, (ImVec2){1, 1});
+    }
+}
+
+// Frame-time percentiles + histogram (EMAs hide single-frame hitches)
+static void draw_profiler_panel(void) {
+    ProfFrameStats st;
+    prof_frame_stats(&st);
+
+    igSetNextWindowPos((ImVec2){10, 380}, ImGuiCond_FirstUseEver, (ImVec2){0, 0});
+    igSetNextWindowSize((ImVec2){290, 210}, ImGuiCond_FirstUseEver);
+    igBegin("Profiler", NULL, 0);
+
+    igText("p50: %.2f  p95: %.2f", st.p50, st.p95);
+    igText("p99: %.2f  max: %.2f", st.p99, st.max);
+    igTextDisabled("over last %d frames (ms)", st.count);
+
+    igPlotLines_FloatPtr("##frames", st.history, st.count, 0, "frame ms",
+                         0.0f, PROF_HIST_MAX_MS, (ImVec2){-1, 50}, sizeof(f32));
+    igPlotHistogram_FloatPtr("##hist", st.hist, PROF_HIST_BINS, 0, "0-40 ms",
+                             0.0f, FLT_MAX, (ImVec2){-1, 50}, sizeof(f32));
+
+#if GB_PROFILE
+    igTextDisabled("F3: dump trace.json");
+#else
+    igTextDisabled("markers disabled (GB_PROFILE=0)");
+#endif
+    igEnd();
+}
+
+static void phys_history_push(PhysHistory *h, const PhysState *ps) {
+    h->step[h->head]    = ps->frame_profile.step;
+    h->collide[h->head] = ps->frame_profile.collide;
+    h->solve[h->head]   = ps->frame_profile.solve;
+    h->force[h->head]   = ps->frame_force_ms;
+    h->head = (h->head + 1) % PHYS_HIST_LEN;
+}
+
+// Box2D stage times vs our force code, summed over this frame's substeps
+static void draw_physics_internals(const PhysHistory *h, const PhysState *ps) {
+    if (!igCollapsingHeader_TreeNodeFlags("Physics internals", 0))
+        return;
+
+    const b2Profile *p = &ps->frame_profile;
+    igText("Substeps: %d", ps->frame_substeps);
+    igText("Step:     %.3f ms", p->step);
+    igText(" Pairs:   %.3f  Collide: %.3f", p->pairs, p->collide);
+    igText(" Solve:   %.3f  Constr:  %.3f", p->solve, p->solveConstraints);
+    igText(" IntVel:  %.3f  IntPos:  %.3f", p->integrateVelocities, p->integratePositions);
+    igText("Forces:   %.3f ms", ps->frame_force_ms);
+
+    const b2Counters *c = &ps->counters;
+    igText("Bodies %d  Shapes %d  Contacts %d  Islands %d",
+           c->bodyCount, c->shapeCount, c->contactCount, c->islandCount);
+
+    ImVec2 size = { -1, 32 };
+    igPlotLines_FloatPtr("Step",    h->step,    PHYS_HIST_LEN, h->head, NULL, 0.0f, FLT_MAX, size, sizeof(f32));
+    igPlotLines_FloatPtr("Collide", h->collide, PHYS_HIST_LEN, h->head, NULL, 0.0f, FLT_MAX, size, sizeof(f32));
+    igPlotLines_FloatPtr("Solve",   h->solve,   PHYS_HIST_LEN, h->head, NULL, 0.0f, FLT_MAX, size, sizeof(f32));
+    igPlotLines_FloatPtr("Forces",  h->force,   PHYS_HIST_LEN, h->head, NULL, 0.0f, FLT_MAX, size, sizeof(f32));
+}
+
+// Live/peak bytes and allocations per frame, by subsystem
+static void draw_memory_stats(void) {
+    MemStats ms;
+    mem_track_stats(&ms);
+
+    igSeparator();
+    igText("-- Memory (KB live/peak, allocs/frame) --");
+    for (int t = 0; t < MEM_TAG_COUNT; t++) {
+        const MemTagStats *ts = &ms.tags[t];
+        igText("%-6s %6d / %6d  %3d", mem_tag_name((MemTag)t),
+               ts->live_bytes / 1024, ts->peak_bytes / 1024, ts->frame_allocs);
+    }
+    if (ms.heap_size > 0)
+        igText("WASM heap: %llu KB (%d growths)",
+               (unsigned long long)(ms.heap_size / 1024), ms.heap_growths);
+}
+
 SDL_AppResult SDL_AppInit(void **appstate, int argc, char *argv[]) {
     (void)argc;
     (void)argv;
 
+    // Before anything allocates through SDL or Box2D
+    mem_track_install();
+
     AppState *state = SDL_calloc(1, sizeof(AppState));
 
     if (!state)
@@ -71,7 +387,8 @@ SDL_AppResult SDL_AppInit(void **appstate, int argc, char *argv[]) {
         return SDL_APP_FAILURE;
     }
 
-    state->window = SDL_CreateWindow("GravityBoost", WINDOW_W, WINDOW_H, 0);
+    state->window = SDL_CreateWindow("GravityBoost", WINDOW_W, WINDOW_H,
+                                     SDL_WINDOW_RESIZABLE | SDL_WINDOW_HIGH_PIXEL_DENSITY);
     if (!state->window) {
         SDL_Log("SDL_CreateWindow failed: %s", SDL_GetError());
         return SDL_APP_FAILURE;
@@ -96,24 +413,33 @@ SDL_AppResult SDL_AppInit(void **appstate, int argc, char *argv[]) {
         return SDL_APP_FAILURE;
     }
 
-    state->texture = SDL_CreateTexture(state->renderer, SDL_PIXELFORMAT_ABGR8888,
-                                     SDL_TEXTUREACCESS_STREAMING, WINDOW_W, WINDOW_H);
-    if (!state->texture) {
-        SDL_Log("SDL_CreateTexture failed: %s", SDL_GetError());
+    state->last_counter = SDL_GetPerformanceCounter();
+    state->pack = level_pack_get(LEVEL_PACK_PATH);
+    if (!state->pack || state->pack->count == 0) {
+        SDL_Log("No levels in '%s'", LEVEL_PACK_PATH);
         return SDL_APP_FAILURE;
     }
-    SDL_SetTextureScaleMode(state->texture, SDL_SCALEMODE_NEAREST);
-
-    state->last_counter = SDL_GetPerformanceCounter();
     state->level_idx = 0;
+    state->thumb_idx = -1;
     state->show_stars = true;
-
-    // Init game state (creates Box2D world + bodies)
-    if (!game_init(&state->game, level_paths[state->level_idx])) {
-        SDL_Log("game_init failed");
+    state->field_view = FIELD_VIEW_ARROWS;
+    state->heatmap_div = 4;
+    state->dynamic_res = true;
+    state->fixed_res = RENDER_SCALE_MAX;
+
+    jobs_init(0);
+    tex_cache_init(NULL);
+    background_init(0);
+    level_loader_init();
+
+    // The first level is waited for; later ones load behind a transition
+    request_level(state, 0);
+    if (level_loader_wait(state->pending_ref) != LEVEL_LOAD_READY) {
+        SDL_Log("Failed to load '%s'", state->pending_ref);
         return SDL_APP_FAILURE;
     }
-    planet_textures_generate(state->renderer, &state->game);
+    swap_level(state);
+    state->fade = 1.0f;
 
     return SDL_APP_CONTINUE;
 }
@@ -132,13 +458,19 @@ SDL_AppResult SDL_AppEvent(void *appstate, SDL_Event *event) {
     case SDL_EVENT_KEY_DOWN:
         if (event->key.key == SDLK_ESCAPE)
             return SDL_APP_SUCCESS;
-        // R to reset to aim state
-        if (event->key.key == SDLK_R) {
-            planet_textures_destroy(&state->game);
-            game_shutdown(&state->game);
-            game_init(&state->game, level_paths[state->level_idx]);
-            planet_textures_generate(state->renderer, &state->game);
-        }
+        // F3 to dump a Chrome/Perfetto trace of the profiler ring buffers
+        if (event->key.key == SDLK_F3)
+            prof_dump_trace("trace.json");
+        // R to reset to aim state (ignored while switching levels)
+        if (event->key.key == SDLK_R && !state->pending_ref[0])
+            restart_level(state);
+        break;
+
+    case SDL_EVENT_RENDER_TARGETS_RESET:
+    case SDL_EVENT_RENDER_DEVICE_RESET:
+        // Render target contents are gone: the planet atlas and static layer
+        planet_textures_restore(state->renderer, &state->game);
+        static_layer_invalidate();
         break;
 
     case SDL_EVENT_MOUSE_BUTTON_DOWN:
@@ -183,6 +515,12 @@ SDL_AppResult SDL_AppIterate(void *appstate) {
     f32 dt = (f32)(now - state->last_counter) / (f32)freq;
     state->last_counter = now;
 
+    // Unclamped wall time between frames, for the percentile history and
+    // the resolution controller
+    f32 frame_ms = dt * 1000.0f;
+    prof_frame_end(frame_ms);
+    PROF_BEGIN("frame");
+
     // Clamp dt to avoid physics explosions from lag spikes
     if (dt > 0.05f) dt = 0.05f;  // cap at 20 FPS minimum step
 
@@ -196,44 +534,103 @@ SDL_AppResult SDL_AppIterate(void *appstate) {
     u64 t0, t1, t2, t3, t4;
     f32 smooth = 0.05f;  // EMA smoothing factor
 
+    PROF_BEGIN("level_poll");
+    poll_level(state, dt);
+    PROF_END();
+
     // --- Physics ---
     t0 = SDL_GetPerformanceCounter();
+    PROF_BEGIN("physics");
     game_update(&state->game, dt);
+    PROF_END();
+    phys_history_push(&state->phys_hist, &state->game.phys);
+    if (state->game.state == GAME_STATE_SUCCESS || state->game.state == GAME_STATE_FAIL)
+        replay_flush(state);
     t1 = SDL_GetPerformanceCounter();
 
     // --- Render ---
+    PROF_BEGIN("render");
+    // Effects for this frame's physics events, then advance the pool
+    PROF_BEGIN("particles_update");
+    particles_update(&state->game, dt);
+    PROF_END();
+    // Swap in planet textures re-sized for the current zoom
+    PROF_BEGIN("planet_gen_poll");
+    planet_gen_poll(state->renderer, &state->game);
+    PROF_END();
+    // The world goes into the scaled internal target; ImGui stays native
+    render_scale_begin(state->renderer, state->window, &state->game.cam);
     SDL_SetRenderDrawColor(state->renderer, 10, 10, 18, 255);
     SDL_RenderClear(state->renderer);
 
-    if (state->show_stars)
+    // Everything below queues into the frame batch; batch_flush submits it
+    batch_begin(state->renderer);
+    if (state->show_stars) {
+        PROF_BEGIN("render_background");
         render_background(state->renderer, dt);
-    render_bounds(state->renderer, &state->game);
+        PROF_END();
+    }
+    bool heatmap = state->game.show_field && state->field_view != FIELD_VIEW_ARROWS;
+    if (heatmap && ensure_heatmap_texture(state)) {
+        PROF_BEGIN("render_heatmap");
+        HeatmapMode mode = state->field_view == FIELD_VIEW_POTENTIAL
+                         ? HEATMAP_POTENTIAL : HEATMAP_ACCEL;
+        render_heatmap(state->renderer, state->texture, &state->game,
+                       mode, state->heatmap_div);
+        PROF_END();
+    }
+    PROF_BEGIN("render_static_layer");
+    render_static_layer(state->renderer, &state->game);
+    PROF_END();
+    PROF_BEGIN("render_planets");
     render_planets(state->renderer, &state->game);
-    if (state->game.show_field)
+    PROF_END();
+    if (state->game.show_field && !heatmap) {
+        PROF_BEGIN("render_gravity_field");
         render_gravity_field(state->renderer, &state->game);
+        PROF_END();
+    }
+    PROF_BEGIN("render_trails");
+    render_trails(state->renderer, &state->game);
+    PROF_END();
+    PROF_BEGIN("render_particles");
+    render_particles(state->renderer, &state->game);
+    PROF_END();
+    PROF_BEGIN("render_ship");
     render_ship(state->renderer, &state->game);
+    PROF_END();
+    PROF_BEGIN("render_flush");
+    batch_flush();
+    PROF_END();
+    PROF_BEGIN("render_upscale");
+    render_scale_end(state->renderer);
+    PROF_END();
+    PROF_END();
+    PROF_COUNTER("render.draw_calls", batch_stats().draw_calls);
+    PROF_COUNTER("render.culled", batch_stats().culled);
+    PROF_COUNTER("render.scale", render_scale_stats().scale);
+    PROF_COUNTER("particles.live", particles_count());
     t2 = SDL_GetPerformanceCounter();
 
     // --- ImGui ---
+    PROF_BEGIN("imgui");
     ImGui_SDL3_NewFrame();
 
     igSetNextWindowPos((ImVec2){10, 10}, ImGuiCond_FirstUseEver, (ImVec2){0, 0});
-    igSetNextWindowSize((ImVec2){250, 260}, ImGuiCond_FirstUseEver);
+    igSetNextWindowSize((ImVec2){290, 360}, ImGuiCond_FirstUseEver);
     igBegin("GravityBoost", NULL, 0);
     igText("FPS: %.1f", state->fps_smooth);
     igSeparator();
 
-    int prev_idx = state->level_idx;
-    igCombo_Str_arr("Level", &state->level_idx, level_names, NUM_LEVELS, -1);
-    if (state->level_idx != prev_idx) {
-        planet_textures_destroy(&state->game);
-        game_shutdown(&state->game);
-        game_init(&state->game, level_paths[state->level_idx]);
-        planet_textures_generate(state->renderer, &state->game);
-    }
+    draw_level_select(state);
 
     igCheckbox("Stars", &state->show_stars);
     igCheckbox("Gravity Field", &state->game.show_field);
+    if (state->game.show_field) {
+        igCombo_Str_arr("View", &state->field_view, field_view_names, FIELD_VIEW_COUNT, -1);
+        if (state->field_view != FIELD_VIEW_ARROWS)
+            igSliderInt("Res 1/N", &state->heatmap_div, 1, 8, "%d", 0);
+    }
     igSeparator();
     igText("Fleet: %d/%d alive", state->game.alive_count, state->game.fleet_count);
     igText("Arrived: %d/%d required", state->game.arrived_count, state->game.required_ships);
@@ -246,14 +643,43 @@ SDL_AppResult SDL_AppIterate(void *appstate) {
     igText("ImGui:    %.2f", state->timing.imgui);
     igText("Present:  %.2f", state->timing.present);
     igText("Total:    %.2f", state->timing.total);
+    BatchStats bs = batch_stats();
+    igText("Draw calls: %d  (%d verts)", bs.draw_calls, bs.vertices);
+    igText("Objects: %d drawn, %d culled", bs.drawn, bs.culled);
+    igText("Particles: %d / %d", particles_count(), PARTICLE_CAPACITY);
+
+    RenderScaleStats rs = render_scale_stats();
+    igText("Resolution: %dx%d (%.0f%%, %.1fx DPI)", rs.width, rs.height,
+           rs.scale * 100.0f, rs.density);
+    igText("Frame budget: %.2f ms (busy %.2f + present %.2f)",
+           rs.budget_ms, rs.busy_ms, rs.present_ms);
+    if (igCheckbox("Dynamic resolution", &state->dynamic_res)) {
+        if (state->dynamic_res) render_scale_set_adaptive(true);
+        else                    render_scale_set(state->fixed_res);
+    }
+    if (!state->dynamic_res &&
+        igSliderFloat("Scale", &state->fixed_res, RENDER_SCALE_MIN, RENDER_SCALE_MAX, "%.2f", 0))
+        render_scale_set(state->fixed_res);
+
+    draw_memory_stats();
+
+    igSeparator();
+    draw_physics_internals(&state->phys_hist, &state->game.phys);
 
     igEnd();
 
+    draw_profiler_panel();
+    draw_transition(state);
+
     // --- Present ---
     ImGui_SDL3_Render(state->renderer);
+    PROF_END();
     t3 = SDL_GetPerformanceCounter();
+    PROF_BEGIN("present");
     SDL_RenderPresent(state->renderer);
+    PROF_END();
     t4 = SDL_GetPerformanceCounter();
+    PROF_END(); // frame
 
     // Update smoothed timings
     f32 ms_phys    = (f32)(t1 - t0) / (f32)freq * 1000.0f;
@@ -268,6 +694,10 @@ SDL_AppResult SDL_AppIterate(void *appstate) {
     state->timing.present  += (ms_present - state->timing.present)  * smooth;
     state->timing.total    += (ms_total   - state->timing.total)    * smooth;
 
+    render_scale_update(frame_ms, ms_total - ms_present, ms_present);
+
+    mem_track_frame_end();
+
     return SDL_APP_CONTINUE;
 }
 
@@ -276,11 +706,21 @@ void SDL_AppQuit(void *appstate, SDL_AppResult result) {
     AppState *state = appstate;
     if (!state) return;
 
-    background_shutdown();
+    replay_flush(state);
+    level_loader_shutdown();
+    jobs_shutdown();
+    static_layer_shutdown();
+    render_scale_shutdown();
     planet_textures_destroy(&state->game);
+    planet_gen_shutdown();
+    tex_cache_shutdown();
     game_shutdown(&state->game);
     ImGui_SDL3_Shutdown();
+    prof_shutdown();
+
+    level_pack_release();
 
+    if (state->thumb)    SDL_DestroyTexture(state->thumb);
     if (state->texture)  SDL_DestroyTexture(state->texture);
     if (state->renderer) SDL_DestroyRenderer(state->renderer);
     if (state->window)   SDL_DestroyWindow(state->window);
@@ -1,5 +1,7 @@
 #include "physics/phys_gravity.h"
+#include "utils/q_simd.h"
 #include <math.h>
+#include <string.h>
 
 Vec2 gravity_accel(Vec2 pos, const Planet *planets, s32 planet_count) {
     Vec2 accel = { 0.0f, 0.0f };
@@ -26,3 +28,65 @@ Vec2 gravity_accel(Vec2 pos, const Planet *planets, s32 planet_count) {
 
     return accel;
 }
+
+void gravity_sources_build(GravitySources *src, const Planet *planets, s32 planet_count) {
+    memset(src, 0, sizeof(*src));
+    s32 n = MIN(planet_count, MAX_PLANETS);
+    for (s32 i = 0; i < n; i++) {
+        src->x[i]      = planets[i].pos.x;
+        src->y[i]      = planets[i].pos.y;
+        src->mu[i]     = planets[i].mu;
+        src->eps_sq[i] = planets[i].eps * planets[i].eps;
+    }
+    src->count = n;
+}
+
+void gravity_field_batch(const GravitySources *src,
+                         const f32 *xs, const f32 *ys, s32 n,
+                         f32 *ax, f32 *ay, f32 *phi) {
+    s32 i = 0;
+
+    // Points across lanes, planets broadcast
+    for (; i + F32X4_WIDTH <= n; i += F32X4_WIDTH) {
+        f32x4 px = f32x4_load(xs + i);
+        f32x4 py = f32x4_load(ys + i);
+        f32x4 acc_x = f32x4_set1(0.0f);
+        f32x4 acc_y = f32x4_set1(0.0f);
+        f32x4 acc_p = f32x4_set1(0.0f);
+
+        for (s32 k = 0; k < src->count; k++) {
+            f32x4 dx = f32x4_sub(f32x4_set1(src->x[k]), px);
+            f32x4 dy = f32x4_sub(f32x4_set1(src->y[k]), py);
+            f32x4 soft_sq = f32x4_madd(dx, dx, f32x4_madd(dy, dy, f32x4_set1(src->eps_sq[k])));
+            f32x4 root = f32x4_sqrt(soft_sq);
+            f32x4 mu_over_r = f32x4_div(f32x4_set1(src->mu[k]), root);
+            f32x4 scale = f32x4_div(mu_over_r, soft_sq);
+
+            acc_x = f32x4_madd(scale, dx, acc_x);
+            acc_y = f32x4_madd(scale, dy, acc_y);
+            acc_p = f32x4_sub(acc_p, mu_over_r);
+        }
+
+        f32x4_store(ax + i, acc_x);
+        f32x4_store(ay + i, acc_y);
+        if (phi) f32x4_store(phi + i, acc_p);
+    }
+
+    // Tail
+    for (; i < n; i++) {
+        f32 acc_x = 0.0f, acc_y = 0.0f, acc_p = 0.0f;
+        for (s32 k = 0; k < src->count; k++) {
+            f32 dx = src->x[k] - xs[i];
+            f32 dy = src->y[k] - ys[i];
+            f32 soft_sq = dx * dx + dy * dy + src->eps_sq[k];
+            f32 mu_over_r = src->mu[k] / sqrtf(soft_sq);
+            f32 scale = mu_over_r / soft_sq;
+            acc_x += scale * dx;
+            acc_y += scale * dy;
+            acc_p -= mu_over_r;
+        }
+        ax[i] = acc_x;
+        ay[i] = acc_y;
+        if (phi) phi[i] = acc_p;
+    }
+}
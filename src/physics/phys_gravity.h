@@ -9,3 +9,23 @@
 //   a(x) = Σ_k  μ_k * (p_k - x) / (||p_k - x||² + ε_k²)^(3/2)
 //
 Vec2 gravity_accel(Vec2 pos, const Planet *planets, s32 planet_count);
+
+// Planets as structure-of-arrays for the batch path
+typedef struct {
+    f32 x[MAX_PLANETS];
+    f32 y[MAX_PLANETS];
+    f32 mu[MAX_PLANETS];
+    f32 eps_sq[MAX_PLANETS];
+    s32 count;
+} GravitySources;
+
+void gravity_sources_build(GravitySources *src, const Planet *planets, s32 planet_count);
+
+// Evaluate the field at `n` points (xs[i], ys[i]), four at a time.
+// Writes acceleration to ax/ay and, if `phi` is non-NULL, the softened
+// potential  φ(x) = -Σ_k μ_k / sqrt(||p_k - x||² + ε_k²).
+// Visualization only: the simulation keeps using gravity_accel so replays
+// stay bit-exact across SIMD backends.
+void gravity_field_batch(const GravitySources *src,
+                         const f32 *xs, const f32 *ys, s32 n,
+                         f32 *ax, f32 *ay, f32 *phi);
@@ -1,6 +1,11 @@
 #include "physics/physics.h"
 #include "physics/phys_gravity.h"
+#include "data/replay.h"
+#include "utils/profiler.h"
+#include <SDL3/SDL_atomic.h>
+#include <SDL3/SDL_timer.h>
 #include <stdint.h>
+#include <string.h>
 #include <math.h>
 
 // --- Separation force helpers (from scratch_ideas.c) ---
@@ -101,13 +106,22 @@ static void fleet_apply_tether(
 
 // --- Physics init ---
 
+// Box2D hands out worlds from one global table without locking. The replay
+// verifier creates and destroys a world per replay on every core, and the
+// level loader builds worlds on its own thread while the main thread
+// destroys one, so creation and destruction take this lock. Everything
+// else works on a single world and needs none.
+static SDL_SpinLock world_lock;
+
 void physics_init(Game *game) {
     PhysState *ps = &game->phys;
 
     // Create world with zero gravity (we apply our own softened model)
     b2WorldDef world_def = b2DefaultWorldDef();
     world_def.gravity = (b2Vec2){ 0.0f, 0.0f };
+    SDL_LockSpinlock(&world_lock);
     ps->world = b2CreateWorld(&world_def);
+    SDL_UnlockSpinlock(&world_lock);
 
     // --- Fleet ships (dynamic, bullet for CCD) ---
     for (s32 i = 0; i < game->fleet_count; i++) {
@@ -158,7 +172,9 @@ void physics_init(Game *game) {
         b2CreateCircleShape(ps->goal_body, &shape_def, &circle);
     }
 
-    ps->active = true;
+    ps->accumulator = 0.0f;
+    ps->substep     = 0;
+    ps->active      = true;
 }
 
 void physics_launch(Game *game, Vec2 vel) {
@@ -166,12 +182,29 @@ void physics_launch(Game *game, Vec2 vel) {
     b2Body_SetLinearVelocity(game->phys.ship_bodies[0], (b2Vec2){ vel.x, vel.y });
 }
 
-#define PHYS_DT (1.0f / 120.0f)   // fixed physics timestep
 #define PHYS_MAX_STEPS 8          // cap substeps per frame to avoid spiral of death
 
+// b2Profile is a flat struct of millisecond floats; summing it as an array
+// keeps this independent of which stages the Box2D version reports.
+static void profile_accumulate(b2Profile *acc, const b2Profile *p) {
+    f32 *dst = (f32 *)acc;
+    const f32 *src = (const f32 *)p;
+    for (size_t i = 0; i < sizeof(b2Profile) / sizeof(f32); i++)
+        dst[i] += src[i];
+}
+
+static void push_event(Game *game, GameEventType type, s32 ship) {
+    PhysState *ps = &game->phys;
+    if (ps->event_count >= MAX_GAME_EVENTS) return;
+    ps->events[ps->event_count++] = (GameEvent){
+        type, ship, game->ships[ship].pos, game->ships[ship].vel,
+    };
+}
+
 // Run one fixed-size substep: apply forces, step Box2D, process events
 static void physics_substep(Game *game) {
     PhysState *ps = &game->phys;
+    u64 force_start = SDL_GetPerformanceCounter();
 
     // Collect alive flags for separation
     bool alive_flags[MAX_FLEET];
@@ -199,9 +232,17 @@ static void physics_substep(Game *game) {
     fleet_apply_separation(ps->ship_bodies, alive_flags, game->fleet_count,
                            2.0f, 15.0f, 5.0f);
 
+    ps->frame_force_ms += (f32)(SDL_GetPerformanceCounter() - force_start) * 1000.0f
+                        / (f32)SDL_GetPerformanceFrequency();
+
     // Step the Box2D world at fixed timestep
     b2World_Step(ps->world, PHYS_DT, 4);
 
+    b2Profile prof = b2World_GetProfile(ps->world);
+    profile_accumulate(&ps->frame_profile, &prof);
+    ps->counters = b2World_GetCounters(ps->world);
+    ps->frame_substeps++;
+
     // Sync position and velocity back to game state for all alive ships
     for (s32 i = 0; i < game->fleet_count; i++) {
         if (!game->ships[i].alive) continue;
@@ -211,6 +252,7 @@ static void physics_substep(Game *game) {
         b2Vec2 new_vel = b2Body_GetLinearVelocity(ps->ship_bodies[i]);
         game->ships[i].pos = (Vec2){ new_pos.x, new_pos.y };
         game->ships[i].vel = (Vec2){ new_vel.x, new_vel.y };
+        trail_sample(&game->trails[i], new_pos.x, new_pos.y);
 
         f32 speed = vec2_len(game->ships[i].vel);
         if (speed > 0.01f) {
@@ -228,6 +270,7 @@ static void physics_substep(Game *game) {
             game->ships[i].alive = false;
             game->alive_count--;
             b2Body_Disable(ps->ship_bodies[i]);
+            push_event(game, GAME_EVENT_SHIP_LOST, i);
 
             if (game->alive_count < game->required_ships) {
                 game->state = GAME_STATE_FAIL;
@@ -261,6 +304,7 @@ static void physics_substep(Game *game) {
 
                 // Disable the body
                 b2Body_Disable(ps->ship_bodies[idx]);
+                push_event(game, GAME_EVENT_SHIP_CRASHED, idx);
 
                 // Check if impossible to win
                 if (game->alive_count < game->required_ships) {
@@ -287,6 +331,7 @@ static void physics_substep(Game *game) {
 
                 // Disable body (docked at goal)
                 b2Body_Disable(ps->ship_bodies[idx]);
+                push_event(game, GAME_EVENT_SHIP_ARRIVED, idx);
 
                 if (game->arrived_count >= game->required_ships) {
                     game->state = GAME_STATE_SUCCESS;
@@ -297,9 +342,36 @@ static void physics_substep(Game *game) {
     }
 }
 
+void physics_tick(Game *game) {
+    PROF_BEGIN("physics_substep");
+    physics_substep(game);
+    game->phys.substep++;
+    if (game->replay)
+        replay_record_substep(game->replay, game);
+    PROF_END();
+}
+
+// Export this frame's Box2D breakdown as profiler counter tracks
+static void physics_emit_counters(const PhysState *ps) {
+    PROF_COUNTER("b2.step_ms",    ps->frame_profile.step);
+    PROF_COUNTER("b2.pairs_ms",   ps->frame_profile.pairs);
+    PROF_COUNTER("b2.collide_ms", ps->frame_profile.collide);
+    PROF_COUNTER("b2.solve_ms",   ps->frame_profile.solve);
+    PROF_COUNTER("phys.force_ms", ps->frame_force_ms);
+    PROF_COUNTER("b2.contacts",   ps->counters.contactCount);
+    PROF_COUNTER("b2.bodies",     ps->counters.bodyCount);
+    (void)ps;
+}
+
 void physics_step(Game *game, f32 dt) {
     PhysState *ps = &game->phys;
     if (!ps->active) return;
+
+    memset(&ps->frame_profile, 0, sizeof(ps->frame_profile));
+    ps->frame_force_ms = 0.0f;
+    ps->frame_substeps = 0;
+    ps->event_count    = 0;
+
     if (game->state != GAME_STATE_PLAYING) return;
 
     // Fixed-timestep accumulator: decouple physics from render frame rate
@@ -307,26 +379,31 @@ void physics_step(Game *game, f32 dt) {
 
     int steps = 0;
     while (ps->accumulator >= PHYS_DT && steps < PHYS_MAX_STEPS) {
-        physics_substep(game);
+        physics_tick(game);
         ps->accumulator -= PHYS_DT;
         steps++;
 
         // Early out if game state changed (fail/success)
         if (game->state != GAME_STATE_PLAYING) {
             ps->accumulator = 0.0f;
-            return;
+            break;
         }
     }
 
     // If we hit the step cap, drain the accumulator to prevent spiral of death
     if (ps->accumulator > PHYS_DT)
         ps->accumulator = 0.0f;
+
+    if (ps->frame_substeps > 0)
+        physics_emit_counters(ps);
 }
 
 void physics_shutdown(Game *game) {
     PhysState *ps = &game->phys;
     if (!ps->active) return;
 
+    SDL_LockSpinlock(&world_lock);
     b2DestroyWorld(ps->world);
+    SDL_UnlockSpinlock(&world_lock);
     ps->active = false;
 }
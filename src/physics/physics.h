@@ -18,12 +18,17 @@ static inline int phys_tag_ship_index(void *tag) {
     return (int)((uintptr_t)tag - PHYS_TAG_SHIP_BASE);
 }
 
+#define PHYS_DT (1.0f / 120.0f)   // fixed physics timestep
+
 // Create Box2D world and bodies for all game objects
 void physics_init(Game *game);
 
 // Apply gravity forces, step world, sync state back, check collisions
 void physics_step(Game *game, f32 dt);
 
+// Run exactly one fixed PHYS_DT substep (replay re-simulation)
+void physics_tick(Game *game);
+
 // Set leader ship velocity (called on launch)
 void physics_launch(Game *game, Vec2 vel);
 
@@ -0,0 +1,237 @@
+#include "render/planet_atlas.h"
+#include "render/render.h"
+
+#define MIN_CELL    32      // smallest image edge
+#define MAX_DEPTH   7       // log2(PLANET_ATLAS_MAX_SIZE / MIN_CELL)
+#define NODE_COUNT  (((1 << (2 * (MAX_DEPTH + 1))) - 1) / 3)
+#define MAX_ENTRIES 64
+
+// Implicit quadtree over the page: node n has children 4n+1 .. 4n+4
+// (top-left, top-right, bottom-left, bottom-right).
+enum { NODE_FREE, NODE_SPLIT, NODE_USED };
+
+typedef struct {
+    u64  key;
+    s32  x, y, size;
+    s32  refs;
+    bool used;
+} AtlasEntry;
+
+static SDL_Texture *page;
+static s32          page_size;      // 0 = no page
+static u8           nodes[NODE_COUNT];
+static AtlasEntry   entries[MAX_ENTRIES];
+static u32          generation;     // space freed
+
+// ---------------------------------------------------------------------------
+// Buddy allocator
+// ---------------------------------------------------------------------------
+
+static bool node_alloc(s32 n, s32 nx, s32 ny, s32 nsize, s32 size, s32 *x, s32 *y) {
+    if (nodes[n] == NODE_USED) return false;
+    if (nsize == size) {
+        if (nodes[n] != NODE_FREE) return false;
+        nodes[n] = NODE_USED;
+        *x = nx;
+        *y = ny;
+        return true;
+    }
+
+    bool was_free = nodes[n] == NODE_FREE;
+    nodes[n] = NODE_SPLIT;
+    s32 half = nsize / 2;
+    for (s32 c = 0; c < 4; c++) {
+        if (node_alloc(4 * n + 1 + c, nx + (c & 1) * half, ny + (c >> 1) * half,
+                       half, size, x, y))
+            return true;
+    }
+    if (was_free) nodes[n] = NODE_FREE;
+    return false;
+}
+
+// Child of node (nx, ny, nsize) containing (x, y)
+static s32 child_of(s32 nx, s32 ny, s32 half, s32 x, s32 y) {
+    return (x >= nx + half) | ((y >= ny + half) << 1);
+}
+
+static void node_mark(s32 n, s32 nx, s32 ny, s32 nsize, s32 x, s32 y, s32 size) {
+    if (nsize == size) {
+        nodes[n] = NODE_USED;
+        return;
+    }
+    nodes[n] = NODE_SPLIT;
+    s32 half = nsize / 2;
+    s32 c = child_of(nx, ny, half, x, y);
+    node_mark(4 * n + 1 + c, nx + (c & 1) * half, ny + (c >> 1) * half, half, x, y, size);
+}
+
+// Free the cell and merge emptied parents; returns true if `n` is now free
+static bool node_free(s32 n, s32 nx, s32 ny, s32 nsize, s32 x, s32 y, s32 size) {
+    if (nsize == size) {
+        nodes[n] = NODE_FREE;
+        return true;
+    }
+    s32 half = nsize / 2;
+    s32 c = child_of(nx, ny, half, x, y);
+    if (!node_free(4 * n + 1 + c, nx + (c & 1) * half, ny + (c >> 1) * half,
+                   half, x, y, size))
+        return false;
+    for (s32 k = 1; k <= 4; k++) {
+        if (nodes[4 * n + k] != NODE_FREE) return false;
+    }
+    nodes[n] = NODE_FREE;
+    return true;
+}
+
+// ---------------------------------------------------------------------------
+// Page
+// ---------------------------------------------------------------------------
+
+static s32 max_page_size(SDL_Renderer *renderer) {
+    s64 limit = SDL_GetNumberProperty(SDL_GetRendererProperties(renderer),
+                                      SDL_PROP_RENDERER_MAX_TEXTURE_SIZE_NUMBER,
+                                      PLANET_ATLAS_MAX_SIZE);
+    s32 size = PLANET_ATLAS_MAX_SIZE;
+    while (size > PLANET_ATLAS_MIN_SIZE && size > limit) size /= 2;
+    return size;
+}
+
+// Replace the page with an empty one of `size` and copy the old contents
+// into its top-left corner; entries keep their texel positions.
+static bool resize_page(SDL_Renderer *renderer, s32 size) {
+    SDL_Texture *tex = SDL_CreateTexture(renderer, SDL_PIXELFORMAT_RGBA32,
+                                         SDL_TEXTUREACCESS_TARGET, size, size);
+    if (!tex) {
+        SDL_Log("planet_atlas: failed to create %dpx page: %s", size, SDL_GetError());
+        return false;
+    }
+    SDL_SetTextureScaleMode(tex, SDL_SCALEMODE_LINEAR);
+
+    batch_flush();
+    SDL_Texture *prev_target = SDL_GetRenderTarget(renderer);
+    u8 r, g, b, a;
+    SDL_GetRenderDrawColor(renderer, &r, &g, &b, &a);
+
+    SDL_SetRenderTarget(renderer, tex);
+    SDL_SetRenderDrawColor(renderer, 0, 0, 0, 0);
+    SDL_RenderClear(renderer);
+    if (page) {
+        SDL_SetTextureBlendMode(page, SDL_BLENDMODE_NONE);
+        SDL_FRect dst = { 0, 0, (f32)page_size, (f32)page_size };
+        SDL_RenderTexture(renderer, page, NULL, &dst);
+        SDL_DestroyTexture(page);
+    }
+    SDL_SetRenderTarget(renderer, prev_target);
+    SDL_SetRenderDrawColor(renderer, r, g, b, a);
+    SDL_SetTextureBlendMode(tex, SDL_BLENDMODE_BLEND);
+
+    page      = tex;
+    page_size = size;
+
+    // The root grew; rebuild the tree from the live entries
+    SDL_memset(nodes, 0, sizeof(nodes));
+    for (s32 i = 0; i < MAX_ENTRIES; i++) {
+        if (entries[i].used)
+            node_mark(0, 0, 0, page_size, entries[i].x, entries[i].y, entries[i].size);
+    }
+    return true;
+}
+
+// ---------------------------------------------------------------------------
+// Public API
+// ---------------------------------------------------------------------------
+
+u32 planet_atlas_add(SDL_Renderer *renderer, u64 key, s32 size, const u8 *rgba) {
+    if (size < MIN_CELL || size > PLANET_ATLAS_MAX_SIZE || (size & (size - 1))) {
+        SDL_Log("planet_atlas: unsupported image size %d", size);
+        return 0;
+    }
+
+    s32 slot = -1;
+    for (s32 i = 0; i < MAX_ENTRIES && slot < 0; i++) {
+        if (!entries[i].used) slot = i;
+    }
+    if (slot < 0) {
+        SDL_Log("planet_atlas: out of entries");
+        return 0;
+    }
+
+    if (!page && !resize_page(renderer, MAX(PLANET_ATLAS_MIN_SIZE, size)))
+        return 0;
+
+    s32 x = 0, y = 0;
+    while (size > page_size || !node_alloc(0, 0, 0, page_size, size, &x, &y)) {
+        if (page_size >= max_page_size(renderer) || !resize_page(renderer, page_size * 2)) {
+            SDL_Log("planet_atlas: no room for a %dpx image", size);
+            return 0;
+        }
+    }
+
+    SDL_Rect rect = { x, y, size, size };
+    if (!SDL_UpdateTexture(page, &rect, rgba, size * 4)) {
+        SDL_Log("planet_atlas: failed to upload image: %s", SDL_GetError());
+        node_free(0, 0, 0, page_size, x, y, size);
+        return 0;
+    }
+
+    entries[slot] = (AtlasEntry){ key, x, y, size, 1, true };
+    return (u32)slot + 1;
+}
+
+static AtlasEntry *entry_for(u32 id) {
+    if (id == 0 || id > MAX_ENTRIES || !entries[id - 1].used) return NULL;
+    return &entries[id - 1];
+}
+
+u32 planet_atlas_find(u64 key) {
+    for (s32 i = 0; i < MAX_ENTRIES; i++) {
+        if (entries[i].used && entries[i].key == key) {
+            entries[i].refs++;
+            return (u32)i + 1;
+        }
+    }
+    return 0;
+}
+
+void planet_atlas_release(u32 id) {
+    AtlasEntry *e = entry_for(id);
+    if (!e || --e->refs > 0) return;
+    node_free(0, 0, 0, page_size, e->x, e->y, e->size);
+    e->used = false;
+    generation++;
+
+    for (s32 i = 0; i < MAX_ENTRIES; i++) {
+        if (entries[i].used) return;
+    }
+    // Last one out: drop the page so the next level starts small again
+    planet_atlas_shutdown();
+}
+
+s32 planet_atlas_size(u32 id) {
+    const AtlasEntry *e = entry_for(id);
+    return e ? e->size : 0;
+}
+
+u32 planet_atlas_generation(void) {
+    return generation;
+}
+
+SDL_Texture *planet_atlas_texture(u32 id, SDL_FRect *uv) {
+    const AtlasEntry *e = entry_for(id);
+    if (!e || !page) return NULL;
+
+    // Inset by half a texel so linear filtering never reaches a neighbour
+    f32 inv = 1.0f / (f32)page_size;
+    *uv = (SDL_FRect){ (e->x + 0.5f) * inv, (e->y + 0.5f) * inv,
+                       (e->size - 1.0f) * inv, (e->size - 1.0f) * inv };
+    return page;
+}
+
+void planet_atlas_shutdown(void) {
+    if (page) SDL_DestroyTexture(page);
+    page      = NULL;
+    page_size = 0;
+    SDL_memset(nodes, 0, sizeof(nodes));
+    SDL_memset(entries, 0, sizeof(entries));
+    generation++;
+}
@@ -0,0 +1,32 @@
+#pragma once
+
+#include <SDL3/SDL.h>
+#include "utils/q_util.h"
+
+// Single texture page holding every planet image, so all planet bodies draw
+// as one textured batch. Images are power-of-two squares placed by a buddy
+// (quadtree) allocator, which packs them without gaps and merges freed
+// quadrants back together. The page starts small and doubles (copying its
+// contents on the GPU) up to PLANET_ATLAS_MAX_SIZE or the renderer limit;
+// it is destroyed again once every entry is released.
+//
+// Entries are referred to by id (0 = none) and are reference counted by
+// the caller's cache key, so planets that look the same share one image.
+// Must be used from the main thread, outside an active batch.
+
+#define PLANET_ATLAS_MIN_SIZE 512
+#define PLANET_ATLAS_MAX_SIZE 4096
+
+// Upload a size x size RGBA32 image; returns its id, or 0 when it does not fit
+u32  planet_atlas_add(SDL_Renderer *renderer, u64 key, s32 size, const u8 *rgba);
+// Take another reference to the entry for `key`, or 0 if there is none
+u32  planet_atlas_find(u64 key);
+// Drop one reference; the space is freed with the last one
+void planet_atlas_release(u32 id);
+// Texel edge of an entry (0 for an invalid id)
+s32  planet_atlas_size(u32 id);
+// Bumped whenever space is freed: an image that did not fit may fit now
+u32  planet_atlas_generation(void);
+// Page texture and the entry's uv rect for drawing, or NULL
+SDL_Texture *planet_atlas_texture(u32 id, SDL_FRect *uv);
+void planet_atlas_shutdown(void);
@@ -1,9 +1,23 @@
-#define STB_PERLIN_IMPLEMENTATION
-#include "stb_perlin.h"
 #include "render/planet_gen.h"
+#include "render/planet_noise.h"
+#include "utils/profiler.h"
+#include "utils/jobs.h"
+#include "data/tex_cache.h"
+#include "render/planet_atlas.h"
+#include "render/render_scale.h"
 #include <math.h>
 
-#define TEX_SIZE 256
+// Texture edge is picked per planet from its on-screen size (powers of two)
+#define TEX_MIN_SIZE 32
+#define TEX_MAX_SIZE 1024   // largest sphere mask slot
+
+// Main-thread refinement budget when no worker thread is available
+#define INLINE_PIXELS_PER_POLL (128 * 128)
+
+// Bumped whenever generated pixels change; part of the texture cache key
+#define PLANET_GEN_VERSION 1
+
+#define MAX_MASK_SIZES 8   // power-of-two sizes 8..1024
 
 // RGBA color
 typedef struct { u8 r, g, b, a; } Color;
@@ -64,127 +78,665 @@ static Color palette_sample(const PlanetPalette *pal, f32 t) {
     return color_lerp(pal->stops[seg], pal->stops[seg + 1], frac);
 }
 
-static void generate_planet_texture(SDL_Renderer *renderer, Planet *planet) {
-    SDL_Texture *tex = SDL_CreateTexture(renderer, SDL_PIXELFORMAT_RGBA32,
-                                         SDL_TEXTUREACCESS_STREAMING,
-                                         TEX_SIZE, TEX_SIZE);
-    if (!tex) {
-        SDL_Log("planet_gen: failed to create texture: %s", SDL_GetError());
-        return;
-    }
+// ---------------------------------------------------------------------------
+// Planet-independent precomputation
+// ---------------------------------------------------------------------------
 
-    void *pixels;
-    int pitch;
-    if (!SDL_LockTexture(tex, NULL, &pixels, &pitch)) {
-        SDL_Log("planet_gen: failed to lock texture: %s", SDL_GetError());
-        SDL_DestroyTexture(tex);
-        return;
+// Sphere projection and shading for one texture size. Everything here
+// depends only on the pixel position, so it is shared by every planet.
+typedef struct {
+    s32  size;
+    f32 *nx, *ny, *nz;     // unit-sphere point per pixel (size*size + pad)
+    f32 *shade;            // directional lighting * limb darkening
+    f32 *rim;              // atmosphere blend weight, 0 inside 0.85 radius
+    s32 *span_begin;       // per row: first/last+1 pixel inside the disc
+    s32 *span_end;
+} SphereMask;
+
+static SphereMask masks[MAX_MASK_SIZES];
+
+// Palette gradients sampled at 256 points per planet type
+static Color palette_lut[PLANET_TYPE_COUNT][256];
+static bool  palette_lut_ready;
+
+static void build_palette_luts(void) {
+    for (int t = 0; t < PLANET_TYPE_COUNT; t++)
+        for (int i = 0; i < 256; i++)
+            palette_lut[t][i] = palette_sample(&palettes[t], i / 255.0f);
+    palette_lut_ready = true;
+}
+
+static int mask_slot(s32 size) {
+    int slot = 0;
+    while ((8 << slot) < size && slot < MAX_MASK_SIZES - 1) slot++;
+    return slot;
+}
+
+static bool build_sphere_mask(SphereMask *m, s32 size) {
+    size_t n = (size_t)size * (size_t)size + F32X4_WIDTH;   // pad for 4-wide tail reads
+    f32 *block = SDL_calloc(n * 5, sizeof(f32));
+    s32 *spans = SDL_calloc((size_t)size * 2, sizeof(s32));
+    if (!block || !spans) {
+        SDL_free(block);
+        SDL_free(spans);
+        return false;
     }
+    m->nx    = block;
+    m->ny    = block + n;
+    m->nz    = block + n * 2;
+    m->shade = block + n * 3;
+    m->rim   = block + n * 4;
+    m->span_begin = spans;
+    m->span_end   = spans + size;
 
-    const PlanetPalette *pal = &palettes[planet->type];
-    f32 seed_offset = (f32)(planet->seed % 1000);
-    f32 half = TEX_SIZE * 0.5f;
+    // Directional lighting (top-left light source)
+    const f32 light_x = -0.5f, light_y = -0.5f, light_z = 0.707f;
+    f32 half = size * 0.5f;
 
-    for (int y = 0; y < TEX_SIZE; y++) {
-        u8 *row = (u8 *)pixels + y * pitch;
-        for (int x = 0; x < TEX_SIZE; x++) {
+    for (s32 y = 0; y < size; y++) {
+        s32 begin = size, end = 0;
+        for (s32 x = 0; x < size; x++) {
+            size_t i = (size_t)y * size + x;
             // Normalized coords [-1, 1]
             f32 nx = (x + 0.5f - half) / half;
             f32 ny = (y + 0.5f - half) / half;
             f32 dist2 = nx * nx + ny * ny;
+            m->nx[i] = nx;
+            m->ny[i] = ny;
+            if (dist2 > 1.0f) continue;
 
-            if (dist2 > 1.0f) {
-                // Outside circle — transparent
-                row[x * 4 + 0] = 0;
-                row[x * 4 + 1] = 0;
-                row[x * 4 + 2] = 0;
-                row[x * 4 + 3] = 0;
-                continue;
-            }
-
-            f32 dist = sqrtf(dist2);
+            begin = MIN(begin, x);
+            end   = x + 1;
 
             // Spherical projection: map 2D to 3D sphere surface
+            f32 dist = sqrtf(dist2);
             f32 nz = sqrtf(1.0f - dist2);
-            f32 sx = nx + seed_offset;
-            f32 sy = ny + seed_offset;
-            f32 sz = nz + seed_offset;
+            m->nz[i] = nz;
 
-            // Base terrain noise (fBm, 6 octaves)
-            f32 noise_val = stb_perlin_fbm_noise3(
-                sx * 2.0f, sy * 2.0f, sz * 2.0f,
-                2.0f, 0.5f, 6);
-            // Normalize from ~[-1,1] to [0,1]
-            noise_val = noise_val * 0.5f + 0.5f;
+            f32 dot = nx * light_x + ny * light_y + nz * light_z;
+            if (dot < 0.0f) dot = 0.0f;
+            f32 lighting = 0.3f + 0.7f * dot;   // ambient 0.3 + diffuse 0.7
+            f32 limb = 1.0f - dist * dist * dist;
+            m->shade[i] = lighting * limb;
 
-            // Gas giant banding
-            if (planet->type == PLANET_TYPE_GAS_GIANT) {
-                f32 band = sinf(ny * 12.0f + stb_perlin_noise3(
-                    sx * 3.0f, sy * 3.0f, sz * 3.0f, 0, 0, 0) * 2.0f);
-                noise_val = noise_val * 0.4f + (band * 0.5f + 0.5f) * 0.6f;
+            // Atmospheric rim glow
+            if (dist > 0.85f) {
+                f32 rim_t = (dist - 0.85f) / 0.15f;
+                m->rim[i] = rim_t * rim_t * 0.7f;   // ease in
             }
+        }
+        // The disc is convex, so inside pixels form one span per row
+        m->span_begin[y] = begin < end ? begin : 0;
+        m->span_end[y]   = begin < end ? end : 0;
+    }
+    m->size = size;
+    return true;
+}
+
+// Must run on the main thread before generation jobs for `size` start.
+static const SphereMask *planet_gen_prepare(s32 size) {
+    if (!palette_lut_ready) build_palette_luts();
+
+    SphereMask *m = &masks[mask_slot(size)];
+    if (m->size != size) {
+        if (m->size) {
+            SDL_free(m->nx);
+            SDL_free(m->span_begin);
+        }
+        SDL_memset(m, 0, sizeof(*m));
+        if (!build_sphere_mask(m, size)) {
+            SDL_Log("planet_gen: out of memory for %dpx sphere mask", size);
+            return NULL;
+        }
+    }
+    return m;
+}
+
+static void refine_shutdown(void);
+
+void planet_gen_shutdown(void) {
+    // The refine worker reads the masks; stop it before freeing them
+    refine_shutdown();
+    planet_atlas_shutdown();
+    for (int i = 0; i < MAX_MASK_SIZES; i++) {
+        if (masks[i].size) {
+            SDL_free(masks[i].nx);
+            SDL_free(masks[i].span_begin);
+        }
+        SDL_memset(&masks[i], 0, sizeof(masks[i]));
+    }
+}
+
+// ---------------------------------------------------------------------------
+// Generation kernel
+// ---------------------------------------------------------------------------
+
+// Fill rows [y0, y1) of a size x size RGBA32 image for `planet`.
+// Pure CPU work on a plain buffer, safe to run on any thread.
+static void generate_planet_rows(const Planet *planet, const SphereMask *m,
+                                 u8 *pixels, int pitch, int y0, int y1) {
+    const Color *lut = palette_lut[planet->type];
+    const Color atm = palettes[planet->type].atmosphere;
+    bool gas_giant = planet->type == PLANET_TYPE_GAS_GIANT;
+    f32x4 seed = f32x4_set1((f32)(planet->seed % 1000));
+    s32 size = m->size;
+
+    for (int y = y0; y < y1; y++) {
+        u8 *row = pixels + y * pitch;
+        // Outside circle — transparent
+        SDL_memset(row, 0, (size_t)size * 4);
+
+        s32 end = m->span_end[y];
+        for (s32 x = m->span_begin[y]; x < end; x += F32X4_WIDTH) {
+            size_t i = (size_t)y * size + x;
+            f32x4 ny = f32x4_load(m->ny + i);
+            f32x4 sx = f32x4_add(f32x4_load(m->nx + i), seed);
+            f32x4 sy = f32x4_add(ny, seed);
+            f32x4 sz = f32x4_add(f32x4_load(m->nz + i), seed);
+
+            // Base terrain noise (fBm, 6 octaves), ~[-1,1] -> [0,1]
+            f32x4 two = f32x4_set1(2.0f);
+            f32x4 base = fbm3_x4(f32x4_mul(sx, two), f32x4_mul(sy, two), f32x4_mul(sz, two),
+                                 2.0f, 0.5f, 6);
+            base = f32x4_madd(base, f32x4_set1(0.5f), f32x4_set1(0.5f));
 
             // Surface detail (turbulence at higher frequency)
-            f32 detail = stb_perlin_turbulence_noise3(
-                sx * 5.0f, sy * 5.0f, sz * 5.0f,
-                2.0f, 0.5f, 3);
-            noise_val += detail * 0.15f;
-            if (noise_val < 0.0f) noise_val = 0.0f;
-            if (noise_val > 1.0f) noise_val = 1.0f;
-
-            // Map to palette
-            Color col = palette_sample(pal, noise_val);
-
-            // Directional lighting (top-left light source)
-            f32 light_x = -0.5f, light_y = -0.5f, light_z = 0.707f;
-            f32 dot = nx * light_x + ny * light_y + nz * light_z;
-            if (dot < 0.0f) dot = 0.0f;
-            f32 lighting = 0.3f + 0.7f * dot; // ambient 0.3 + diffuse 0.7
+            f32x4 five = f32x4_set1(5.0f);
+            f32x4 detail = turbulence3_x4(f32x4_mul(sx, five), f32x4_mul(sy, five),
+                                          f32x4_mul(sz, five), 2.0f, 0.5f, 3);
 
-            // Limb darkening
-            f32 limb = 1.0f - dist * dist * dist;
-            f32 brightness = lighting * limb;
+            f32 val[4], det[4], warp[4], nyv[4];
+            f32x4_store(val, base);
+            f32x4_store(det, detail);
 
-            col.r = (u8)(col.r * brightness);
-            col.g = (u8)(col.g * brightness);
-            col.b = (u8)(col.b * brightness);
+            // Gas giant banding
+            if (gas_giant) {
+                f32x4 three = f32x4_set1(3.0f);
+                f32x4_store(warp, noise3_x4(f32x4_mul(sx, three), f32x4_mul(sy, three),
+                                            f32x4_mul(sz, three)));
+                f32x4_store(nyv, ny);
+            }
 
-            // Atmospheric rim glow
-            if (dist > 0.85f) {
-                f32 rim_t = (dist - 0.85f) / 0.15f; // 0..1
-                rim_t = rim_t * rim_t; // ease in
-                col = color_lerp(col, pal->atmosphere, rim_t * 0.7f);
-                // Ensure fully opaque
-                col.a = 255;
+            s32 lanes = MIN(F32X4_WIDTH, end - x);
+            for (s32 l = 0; l < lanes; l++) {
+                f32 v = val[l];
+                if (gas_giant) {
+                    f32 band = sinf(nyv[l] * 12.0f + warp[l] * 2.0f);
+                    v = v * 0.4f + (band * 0.5f + 0.5f) * 0.6f;
+                }
+                v += det[l] * 0.15f;
+                v = CLAMP(v, 0.0f, 1.0f);
+
+                // Map to palette, then shade
+                Color col = lut[(int)(v * 255.0f + 0.5f)];
+                f32 brightness = m->shade[i + l];
+                col.r = (u8)(col.r * brightness);
+                col.g = (u8)(col.g * brightness);
+                col.b = (u8)(col.b * brightness);
+
+                f32 rim = m->rim[i + l];
+                if (rim > 0.0f) {
+                    col = color_lerp(col, atm, rim);
+                    // Ensure fully opaque
+                    col.a = 255;
+                }
+
+                u8 *px = row + (x + l) * 4;
+                px[0] = col.r;
+                px[1] = col.g;
+                px[2] = col.b;
+                px[3] = col.a;
             }
+        }
+    }
+}
+
+// ---------------------------------------------------------------------------
+// Level of detail
+// ---------------------------------------------------------------------------
+
+// Texture edge for a planet drawn `radius_px` points in radius: the power of
+// two covering its diameter in window pixels (HiDPI included, the dynamic
+// resolution scale left out so it does not churn textures). `current`
+// (0 = none) adds hysteresis: grow as soon as the texture would be
+// magnified, but shrink only once it is 4x larger than needed, so zooming
+// around a threshold does not thrash.
+static s32 planet_lod_size(f32 radius_px, s32 current) {
+    radius_px *= render_scale_density();
+    s32 want = TEX_MIN_SIZE;
+    while (want < TEX_MAX_SIZE && (f32)want < 2.0f * radius_px)
+        want *= 2;
+    if (want < current && want * 4 > current)
+        return current;
+    return want;
+}
+
+static s32 planet_texture_size(const Planet *p) {
+    return planet_atlas_size(p->tex_id);
+}
+
+static bool same_look(const Planet *a, const Planet *b) {
+    return a->seed == b->seed && a->type == b->type;
+}
 
-            row[x * 4 + 0] = col.r;
-            row[x * 4 + 1] = col.g;
-            row[x * 4 + 2] = col.b;
-            row[x * 4 + 3] = col.a;
+// LOD size per planet. Planets that look the same share one image, so
+// each group is sized for its largest member.
+static void planet_target_sizes(const Game *game, s32 *target) {
+    for (s32 i = 0; i < game->planet_count; i++) {
+        const Planet *p = &game->planets[i];
+        target[i] = planet_lod_size(world_to_screen_r(&game->cam, p->radius),
+                                    planet_texture_size(p));
+    }
+    for (s32 i = 0; i < game->planet_count; i++) {
+        for (s32 j = 0; j < game->planet_count; j++) {
+            if (same_look(&game->planets[i], &game->planets[j]))
+                target[i] = MAX(target[i], target[j]);
         }
     }
+}
 
-    SDL_UnlockTexture(tex);
-    SDL_SetTextureBlendMode(tex, SDL_BLENDMODE_BLEND);
-    SDL_SetTextureScaleMode(tex, SDL_SCALEMODE_LINEAR);
+// Pixels are a pure function of these; bump PLANET_GEN_VERSION whenever the
+// generator's output changes so stale cache entries stop matching.
+static u64 planet_cache_key(const Planet *p, s32 size) {
+    u32 fields[4] = { PLANET_GEN_VERSION, p->seed, (u32)p->type, (u32)size };
+    return fnv1a64(FNV1A64_SEED, fields, sizeof(fields));
+}
+
+// Keys the atlas had no room for. They are not asked for again until the
+// atlas frees space, so a full page keeps the current textures instead of
+// regenerating (and logging) the same image every poll.
+static u64 unplaced[MAX_PLANETS];
+static s32 unplaced_count;
+static u32 unplaced_generation;
+
+static bool is_unplaced(u64 key) {
+    if (unplaced_generation != planet_atlas_generation()) {
+        unplaced_generation = planet_atlas_generation();
+        unplaced_count = 0;
+    }
+    for (s32 i = 0; i < unplaced_count; i++)
+        if (unplaced[i] == key) return true;
+    return false;
+}
 
-    planet->texture = tex;
+static void mark_unplaced(u64 key) {
+    if (!is_unplaced(key) && unplaced_count < MAX_PLANETS)
+        unplaced[unplaced_count++] = key;
+}
+
+// Place an image in the atlas, remembering a failure
+static u32 atlas_add(SDL_Renderer *renderer, u64 key, s32 size, const u8 *rgba) {
+    u32 id = planet_atlas_add(renderer, key, size, rgba);
+    if (!id) mark_unplaced(key);
+    return id;
+}
+
+// Share an image already in the atlas, else map it in from the disk cache
+static u32 find_texture(SDL_Renderer *renderer, u64 key, s32 size) {
+    u32 id = planet_atlas_find(key);
+    if (id) return id;
+
+    TexCacheEntry entry;
+    if (!tex_cache_load(key, size, size, &entry))
+        return 0;
+    id = atlas_add(renderer, key, size, entry.pixels);
+    tex_cache_release(&entry);
+    return id;
+}
+
+// Point `p` at a new atlas entry, releasing the one it replaces
+static void planet_set_texture(Planet *p, u32 id) {
+    planet_atlas_release(p->tex_id);
+    p->tex_id = id;
+}
+
+// ---------------------------------------------------------------------------
+// Level load
+// ---------------------------------------------------------------------------
+
+// One planet's image within the flattened row range of a batch
+typedef struct {
+    const Planet *planet;
+    u64    key;
+    s32    size;
+    s32    first_row;
+    size_t offset;      // byte offset into the batch buffer
+} PlanetGenTask;
+
+// One job per chunk of rows across every planet that missed the cache
+typedef struct {
+    const PlanetGenTask *tasks;
+    u8                  *pixels;
+} PlanetGenJob;
+
+static void planet_rows_job(void *ctx, s32 begin, s32 end) {
+    const PlanetGenJob *job = ctx;
+    // Flattened (planet, row) index; split ranges at planet boundaries
+    s32 t = 0;
+    while (begin < end) {
+        while (begin >= job->tasks[t].first_row + job->tasks[t].size) t++;
+        const PlanetGenTask *task = &job->tasks[t];
+        s32 y0 = begin - task->first_row;
+        s32 y1 = MIN(task->size, y0 + (end - begin));
+        generate_planet_rows(task->planet, &masks[mask_slot(task->size)],
+                             job->pixels + task->offset, task->size * 4, y0, y1);
+        begin += y1 - y0;
+    }
 }
 
 void planet_textures_generate(SDL_Renderer *renderer, Game *game) {
+    if (game->planet_count <= 0) return;
+    PROF_BEGIN("planet_textures_generate");
+
+    // Cache hits upload straight from the mapped file; planets that look
+    // alike are generated once and share the image
+    PROF_BEGIN("planet_cache_load");
+    s32 target[MAX_PLANETS];
+    planet_target_sizes(game, target);
+
+    PlanetGenTask tasks[MAX_PLANETS];
+    s32 misses[MAX_PLANETS];
+    s32 task_count = 0, rows = 0;
+    s32 sharers[MAX_PLANETS];
+    s32 sharer_count = 0;
+    size_t bytes = 0;
     for (s32 i = 0; i < game->planet_count; i++) {
-        generate_planet_texture(renderer, &game->planets[i]);
-        SDL_Log("planet_gen: planet %d seed=%u type=%d", i,
-                game->planets[i].seed, game->planets[i].type);
+        Planet *p = &game->planets[i];
+        s32 size = target[i];
+        u64 key = planet_cache_key(p, size);
+        p->tex_id = find_texture(renderer, key, size);
+        if (p->tex_id || !planet_gen_prepare(size)) continue;
+
+        bool queued = false;
+        for (s32 t = 0; t < task_count && !queued; t++)
+            queued = tasks[t].key == key;
+        if (queued) {
+            sharers[sharer_count++] = i;
+            continue;
+        }
+
+        misses[task_count] = i;
+        tasks[task_count++] = (PlanetGenTask){ p, key, size, rows, bytes };
+        rows  += size;
+        bytes += (size_t)size * size * 4;
+    }
+    PROF_END();
+
+    if (task_count == 0) {
+        PROF_END();
+        return;
+    }
+
+    u8 *pixels = SDL_malloc(bytes);
+    if (!pixels) {
+        SDL_Log("planet_gen: out of memory for %d textures", task_count);
+        PROF_END();
+        return;
+    }
+
+    // CPU generation on the worker pool; only the upload touches the renderer
+    PROF_BEGIN("planet_pixels");
+    PlanetGenJob job = { .tasks = tasks, .pixels = pixels };
+    jobs_parallel_for(rows, 16, planet_rows_job, &job);
+    PROF_END();
+
+    PROF_BEGIN("planet_upload");
+    for (s32 t = 0; t < task_count; t++) {
+        Planet *p = &game->planets[misses[t]];
+        const u8 *image = pixels + tasks[t].offset;
+        s32 size = tasks[t].size;
+        p->tex_id = planet_atlas_add(renderer, tasks[t].key, size, image);
+        tex_cache_store(tasks[t].key, size, size, image);
+        SDL_Log("planet_gen: planet %d seed=%u type=%d size=%d",
+                misses[t], p->seed, p->type, size);
+    }
+    for (s32 s = 0; s < sharer_count; s++) {
+        Planet *p = &game->planets[sharers[s]];
+        p->tex_id = planet_atlas_find(planet_cache_key(p, target[sharers[s]]));
     }
+    tex_cache_commit();
+    PROF_END();
+
+    SDL_free(pixels);
+    PROF_END();
+}
+
+void planet_texture_release(Planet *p) {
+    planet_set_texture(p, 0);
 }
 
 void planet_textures_destroy(Game *game) {
+    for (s32 i = 0; i < game->planet_count; i++)
+        planet_texture_release(&game->planets[i]);
+}
+
+void planet_textures_restore(SDL_Renderer *renderer, Game *game) {
+    // Ids die with the page; nothing left to release
+    planet_atlas_shutdown();
+    for (s32 i = 0; i < game->planet_count; i++)
+        game->planets[i].tex_id = 0;
+    planet_textures_generate(renderer, game);
+}
+
+// ---------------------------------------------------------------------------
+// Progressive regeneration
+// ---------------------------------------------------------------------------
+
+// A texture at a planet's LOD size, generated off the main thread. Work is
+// keyed by the cache key (which includes the size) rather than the planet
+// index, so results survive planets being reordered or deleted, and results
+// for a seed or zoom level that has since changed match nothing and are
+// dropped.
+typedef struct {
+    u64    key;
+    Planet planet;      // seed/type snapshot for the worker
+    s32    size;
+    u8    *pixels;      // size * size * 4, filled by the worker
+} RefineJob;
+
+static SDL_Thread    *refine_thread;
+static SDL_Mutex     *refine_lock;
+static SDL_Condition *refine_wake;
+static bool           refine_started;
+static bool           refine_quit;
+static bool           refine_queued;        // refine_next is waiting
+static RefineJob      refine_next;          // overwritten by every poll
+static u64            refine_busy_key;      // being generated, 0 = idle
+static RefineJob      refine_done[MAX_PLANETS];
+static s32            refine_done_count;
+
+// Main-thread fallback: one job generated a few rows per poll
+static RefineJob      inline_job;
+static s32            inline_row;
+
+static int SDLCALL refine_worker(void *data) {
+    (void)data;
+    SDL_LockMutex(refine_lock);
+    for (;;) {
+        while (!refine_quit && !refine_queued)
+            SDL_WaitCondition(refine_wake, refine_lock);
+        if (refine_quit) break;
+
+        RefineJob job = refine_next;
+        refine_queued   = false;
+        refine_busy_key = job.key;
+        SDL_UnlockMutex(refine_lock);
+
+        job.pixels = SDL_malloc((size_t)job.size * job.size * 4);
+        if (job.pixels)
+            generate_planet_rows(&job.planet, &masks[mask_slot(job.size)],
+                                 job.pixels, job.size * 4, 0, job.size);
+
+        SDL_LockMutex(refine_lock);
+        refine_busy_key = 0;
+        if (job.pixels && refine_done_count < MAX_PLANETS)
+            refine_done[refine_done_count++] = job;
+        else
+            SDL_free(job.pixels);
+    }
+    SDL_UnlockMutex(refine_lock);
+    return 0;
+}
+
+// Lazily bring up the worker. Without threads (single-threaded web build)
+// planet_gen_poll refines on the main thread a slice at a time instead.
+static void refine_start(void) {
+    if (refine_started) return;
+    refine_started = true;
+
+    refine_lock = SDL_CreateMutex();
+    refine_wake = SDL_CreateCondition();
+    if (refine_lock && refine_wake)
+        refine_thread = SDL_CreateThread(refine_worker, "planet_refine", NULL);
+    if (!refine_thread)
+        SDL_Log("planet_gen: no refine thread, refining on the main thread");
+}
+
+static void refine_shutdown(void) {
+    if (refine_thread) {
+        SDL_LockMutex(refine_lock);
+        refine_quit = true;
+        SDL_SignalCondition(refine_wake);
+        SDL_UnlockMutex(refine_lock);
+        SDL_WaitThread(refine_thread, NULL);
+    }
+    for (s32 i = 0; i < refine_done_count; i++)
+        SDL_free(refine_done[i].pixels);
+    SDL_free(inline_job.pixels);
+    if (refine_wake) SDL_DestroyCondition(refine_wake);
+    if (refine_lock) SDL_DestroyMutex(refine_lock);
+
+    refine_thread = NULL;
+    refine_lock   = NULL;
+    refine_wake   = NULL;
+    refine_started = refine_quit = refine_queued = false;
+    refine_busy_key   = 0;
+    refine_done_count = 0;
+    inline_job = (RefineJob){0};
+    inline_row = 0;
+}
+
+// Advance the main-thread job; returns true once its image is complete
+static bool refine_inline_step(const u64 *want, s32 want_count, const RefineJob *next) {
+    bool wanted = false;
+    for (s32 i = 0; i < want_count && inline_job.pixels; i++)
+        wanted |= want[i] == inline_job.key;
+    if (!wanted) {
+        // Nothing in progress, or the planet moved on: start the next job
+        SDL_free(inline_job.pixels);
+        inline_job = (RefineJob){0};
+        inline_row = 0;
+        if (!next) return false;
+        inline_job = *next;
+        inline_job.pixels = SDL_malloc((size_t)next->size * next->size * 4);
+        if (!inline_job.pixels) return false;
+    }
+
+    s32 size = inline_job.size;
+    s32 y1 = MIN(size, inline_row + MAX(1, INLINE_PIXELS_PER_POLL / size));
+    generate_planet_rows(&inline_job.planet, &masks[mask_slot(size)],
+                         inline_job.pixels, size * 4, inline_row, y1);
+    inline_row = y1;
+    return inline_row == size;
+}
+
+void planet_texture_refresh(SDL_Renderer *renderer, const Camera *cam, Planet *planet) {
+    planet_texture_release(planet);
+
+    s32 size = planet_lod_size(world_to_screen_r(cam, planet->radius), 0);
+    planet->tex_id = find_texture(renderer, planet_cache_key(planet, size), size);
+    if (planet->tex_id) return;
+
+    // A preview costs a fraction of a full texture; planet_gen_poll notices
+    // it is below the LOD size and refines it
+    static u8 preview[PLANET_PREVIEW_SIZE * PLANET_PREVIEW_SIZE * 4];
+    s32 preview_size = MIN(size, PLANET_PREVIEW_SIZE);
+    u64 preview_key = planet_cache_key(planet, preview_size);
+    planet->tex_id = planet_atlas_find(preview_key);
+    if (planet->tex_id || !planet_gen_prepare(preview_size)) return;
+    generate_planet_rows(planet, &masks[mask_slot(preview_size)], preview,
+                         preview_size * 4, 0, preview_size);
+    planet->tex_id = planet_atlas_add(renderer, preview_key, preview_size, preview);
+}
+
+void planet_gen_poll(SDL_Renderer *renderer, Game *game) {
+    // Key each planet wants (0 = its texture is already the right size)
+    u64 want[MAX_PLANETS];
+    s32 target[MAX_PLANETS];
+    bool any = false;
+    planet_target_sizes(game, target);
     for (s32 i = 0; i < game->planet_count; i++) {
-        if (game->planets[i].texture) {
-            SDL_DestroyTexture(game->planets[i].texture);
-            game->planets[i].texture = NULL;
+        const Planet *p = &game->planets[i];
+        bool stale = p->tex_id && target[i] != planet_texture_size(p);
+        want[i] = stale ? planet_cache_key(p, target[i]) : 0;
+        if (want[i] && is_unplaced(want[i])) want[i] = 0;
+        any |= want[i] != 0;
+    }
+    if (!any && !refine_started) return;
+    refine_start();
+
+    // Next job: the first stale planet the worker isn't already on. Cache
+    // hits are swapped in here without queuing anything.
+    RefineJob next = {0};
+    bool has_next = false;
+    u64 busy = 0;
+    if (refine_thread) {
+        SDL_LockMutex(refine_lock);
+        busy = refine_busy_key;
+        SDL_UnlockMutex(refine_lock);
+    }
+    for (s32 i = 0; i < game->planet_count && !has_next; i++) {
+        Planet *p = &game->planets[i];
+        if (!want[i] || want[i] == busy) continue;
+        u32 id = find_texture(renderer, want[i], target[i]);
+        if (id) {
+            planet_set_texture(p, id);
+            want[i] = 0;
+            continue;
+        }
+        if (!planet_gen_prepare(target[i])) continue;
+        next = (RefineJob){ want[i], *p, target[i], NULL };
+        has_next = true;
+    }
+
+    RefineJob done[MAX_PLANETS];
+    s32 done_count = 0;
+    if (refine_thread) {
+        // Replacing the queued job every poll means a scrubbed seed or a
+        // zoom sweep only refines where it comes to rest
+        SDL_LockMutex(refine_lock);
+        SDL_memcpy(done, refine_done, sizeof(RefineJob) * (size_t)refine_done_count);
+        done_count = refine_done_count;
+        refine_done_count = 0;
+        refine_next   = next;
+        refine_queued = has_next;
+        if (has_next) SDL_SignalCondition(refine_wake);
+        SDL_UnlockMutex(refine_lock);
+    } else if (refine_inline_step(want, game->planet_count, has_next ? &next : NULL)) {
+        done[done_count++] = inline_job;
+        inline_job = (RefineJob){0};
+        inline_row = 0;
+    }
+
+    // Swap finished images into every planet still wanting the same key. An
+    // image the atlas cannot hold is still cached for when it can.
+    bool stored = false;
+    for (s32 d = 0; d < done_count; d++) {
+        bool wanted = false;
+        for (s32 i = 0; i < game->planet_count; i++) {
+            Planet *p = &game->planets[i];
+            if (want[i] != done[d].key) continue;
+            wanted = true;
+            u32 id = planet_atlas_find(done[d].key);
+            if (!id && !is_unplaced(done[d].key))
+                id = atlas_add(renderer, done[d].key, done[d].size, done[d].pixels);
+            if (!id) continue;
+            planet_set_texture(p, id);
+            want[i] = 0;
         }
+        if (wanted)
+            stored |= tex_cache_store(done[d].key, done[d].size, done[d].size, done[d].pixels);
+        SDL_free(done[d].pixels);
     }
+    if (stored) tex_cache_commit();
 }
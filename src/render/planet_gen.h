@@ -5,3 +5,24 @@
 
 void planet_textures_generate(SDL_Renderer *renderer, Game *game);
 void planet_textures_destroy(Game *game);
+// The atlas page is a render target, so its contents are lost when the
+// renderer resets its targets or device (SDL_EVENT_RENDER_TARGETS_RESET,
+// SDL_EVENT_RENDER_DEVICE_RESET). Drop it and upload every planet again,
+// mostly straight from the texture cache.
+void planet_textures_restore(SDL_Renderer *renderer, Game *game);
+void planet_texture_release(Planet *p);
+// Free the atlas and shared sphere masks and stop the refine worker
+void planet_gen_shutdown(void);
+
+// Planet textures are sized to the planet's on-screen diameter (a power of
+// two, 32..1024 px) from the camera at load time. planet_gen_poll keeps them
+// matched as the zoom changes: replacements come from the texture cache or
+// are generated on a background thread and swapped in when ready.
+void planet_gen_poll(SDL_Renderer *renderer, Game *game);
+
+// Editor: replace one planet's texture right away after its seed or type
+// changed, with a cache hit or a PLANET_PREVIEW_SIZE preview that
+// planet_gen_poll then refines to full size.
+#define PLANET_PREVIEW_SIZE 64
+
+void planet_texture_refresh(SDL_Renderer *renderer, const Camera *cam, Planet *planet);
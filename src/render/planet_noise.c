@@ -0,0 +1,94 @@
+#include "render/planet_noise.h"
+
+// Lattice hash. Each axis is a multiplicative hash (so the +1 corner is an
+// add, not a multiply); the three are combined and mixed once per corner.
+#define HASH_KX 0x8DA6B343u
+#define HASH_KY 0xD8163841u
+#define HASH_KZ 0xCB1AB31Fu
+
+#define NOISE_SCALE 0.825f
+
+static inline u32x4 hash_mix(u32x4 hx, u32x4 hy, u32x4 hz) {
+    u32x4 h = u32x4_xor(u32x4_xor(hx, hy), hz);
+    return u32x4_mul(h, u32x4_set1(0x2C1B3C6Du));
+}
+
+// Dot with one of the 8 cube-diagonal gradients (±1, ±1, ±1): the top
+// three hash bits are the component signs, applied by flipping float sign
+// bits, so there are no selects or lookups.
+static inline f32x4 grad(u32x4 h, f32x4 x, f32x4 y, f32x4 z) {
+    u32x4 sign = u32x4_set1(0x80000000u);
+    f32x4 gx = f32x4_xor_bits(x, u32x4_and(h, sign));
+    f32x4 gy = f32x4_xor_bits(y, u32x4_and(u32x4_shl(h, 1), sign));
+    f32x4 gz = f32x4_xor_bits(z, u32x4_and(u32x4_shl(h, 2), sign));
+    return f32x4_add(f32x4_add(gx, gy), gz);
+}
+
+static inline f32x4 fade(f32x4 t) {
+    // 6t^5 - 15t^4 + 10t^3
+    f32x4 p = f32x4_madd(t, f32x4_set1(6.0f), f32x4_set1(-15.0f));
+    p = f32x4_madd(p, t, f32x4_set1(10.0f));
+    return f32x4_mul(f32x4_mul(f32x4_mul(t, t), t), p);
+}
+
+static inline f32x4 lerp(f32x4 t, f32x4 a, f32x4 b) {
+    return f32x4_madd(t, f32x4_sub(b, a), a);
+}
+
+f32x4 noise3_x4(f32x4 x, f32x4 y, f32x4 z) {
+    f32x4 fx = f32x4_floor(x), fy = f32x4_floor(y), fz = f32x4_floor(z);
+    u32x4 kx = u32x4_set1(HASH_KX), ky = u32x4_set1(HASH_KY), kz = u32x4_set1(HASH_KZ);
+    u32x4 hx0 = u32x4_mul(u32x4_from_f32(fx), kx), hx1 = u32x4_add(hx0, kx);
+    u32x4 hy0 = u32x4_mul(u32x4_from_f32(fy), ky), hy1 = u32x4_add(hy0, ky);
+    u32x4 hz0 = u32x4_mul(u32x4_from_f32(fz), kz), hz1 = u32x4_add(hz0, kz);
+
+    f32x4 x0 = f32x4_sub(x, fx), y0 = f32x4_sub(y, fy), z0 = f32x4_sub(z, fz);
+    f32x4 onef = f32x4_set1(1.0f);
+    f32x4 x1 = f32x4_sub(x0, onef), y1 = f32x4_sub(y0, onef), z1 = f32x4_sub(z0, onef);
+
+    f32x4 u = fade(x0), v = fade(y0), w = fade(z0);
+
+    f32x4 n000 = grad(hash_mix(hx0, hy0, hz0), x0, y0, z0);
+    f32x4 n100 = grad(hash_mix(hx1, hy0, hz0), x1, y0, z0);
+    f32x4 n010 = grad(hash_mix(hx0, hy1, hz0), x0, y1, z0);
+    f32x4 n110 = grad(hash_mix(hx1, hy1, hz0), x1, y1, z0);
+    f32x4 n001 = grad(hash_mix(hx0, hy0, hz1), x0, y0, z1);
+    f32x4 n101 = grad(hash_mix(hx1, hy0, hz1), x1, y0, z1);
+    f32x4 n011 = grad(hash_mix(hx0, hy1, hz1), x0, y1, z1);
+    f32x4 n111 = grad(hash_mix(hx1, hy1, hz1), x1, y1, z1);
+
+    f32x4 nx00 = lerp(u, n000, n100);
+    f32x4 nx10 = lerp(u, n010, n110);
+    f32x4 nx01 = lerp(u, n001, n101);
+    f32x4 nx11 = lerp(u, n011, n111);
+    f32x4 nxy0 = lerp(v, nx00, nx10);
+    f32x4 nxy1 = lerp(v, nx01, nx11);
+    // Diagonal gradients are √3 long; rescale to stb_perlin's spread
+    return f32x4_mul(lerp(w, nxy0, nxy1), f32x4_set1(NOISE_SCALE));
+}
+
+f32x4 fbm3_x4(f32x4 x, f32x4 y, f32x4 z, f32 lacunarity, f32 gain, int octaves) {
+    f32x4 sum = f32x4_set1(0.0f);
+    f32 freq = 1.0f, amp = 1.0f;
+    for (int i = 0; i < octaves; i++) {
+        f32x4 f = f32x4_set1(freq);
+        f32x4 n = noise3_x4(f32x4_mul(x, f), f32x4_mul(y, f), f32x4_mul(z, f));
+        sum = f32x4_madd(n, f32x4_set1(amp), sum);
+        freq *= lacunarity;
+        amp  *= gain;
+    }
+    return sum;
+}
+
+f32x4 turbulence3_x4(f32x4 x, f32x4 y, f32x4 z, f32 lacunarity, f32 gain, int octaves) {
+    f32x4 sum = f32x4_set1(0.0f);
+    f32 freq = 1.0f, amp = 1.0f;
+    for (int i = 0; i < octaves; i++) {
+        f32x4 f = f32x4_set1(freq);
+        f32x4 n = noise3_x4(f32x4_mul(x, f), f32x4_mul(y, f), f32x4_mul(z, f));
+        sum = f32x4_madd(f32x4_abs(n), f32x4_set1(amp), sum);
+        freq *= lacunarity;
+        amp  *= gain;
+    }
+    return sum;
+}
@@ -0,0 +1,18 @@
+#pragma once
+
+#include "utils/q_simd.h"
+
+// 4-wide 3D gradient noise for planet generation.
+//
+// Improved-Perlin style gradient noise with a quintic fade, scaled to the
+// same spread as stb_perlin so existing tuning constants still apply. The
+// lattice hash is an integer mix rather than a permutation table, so every
+// step stays in vector registers. Output is roughly [-1, 1].
+
+f32x4 noise3_x4(f32x4 x, f32x4 y, f32x4 z);
+
+// Σ noise(p * lacunarity^i) * gain^i over `octaves`
+f32x4 fbm3_x4(f32x4 x, f32x4 y, f32x4 z, f32 lacunarity, f32 gain, int octaves);
+
+// Σ |noise(p * lacunarity^i)| * gain^i over `octaves`
+f32x4 turbulence3_x4(f32x4 x, f32x4 y, f32x4 z, f32 lacunarity, f32 gain, int octaves);
@@ -1 +1,234 @@
 #include "render/render.h"
+#include <math.h>
+
+static SDL_Vertex verts[BATCH_MAX_VERTS];
+static int indices[BATCH_MAX_INDICES];
+static int vert_count;
+static int index_count;
+
+static SDL_Renderer *batch_renderer;
+static SDL_Texture  *cur_texture;
+static SDL_BlendMode cur_blend = SDL_BLENDMODE_BLEND;
+static BatchStats    stats;
+
+void batch_begin(SDL_Renderer *renderer) {
+    batch_renderer = renderer;
+    vert_count  = 0;
+    index_count = 0;
+    cur_texture = NULL;
+    cur_blend   = SDL_BLENDMODE_BLEND;
+    stats = (BatchStats){0};
+}
+
+void batch_flush(void) {
+    if (index_count == 0 || !batch_renderer) {
+        vert_count = index_count = 0;
+        return;
+    }
+
+    // Untextured geometry blends with the draw blend mode; textured geometry
+    // uses the texture's own mode.
+    SDL_BlendMode prev = SDL_BLENDMODE_NONE;
+    SDL_GetRenderDrawBlendMode(batch_renderer, &prev);
+    if (cur_texture)
+        SDL_SetTextureBlendMode(cur_texture, cur_blend);
+    else
+        SDL_SetRenderDrawBlendMode(batch_renderer, cur_blend);
+
+    SDL_RenderGeometry(batch_renderer, cur_texture, verts, vert_count,
+                       indices, index_count);
+    SDL_SetRenderDrawBlendMode(batch_renderer, prev);
+
+    stats.draw_calls++;
+    stats.vertices += vert_count;
+    stats.indices  += index_count;
+    vert_count = index_count = 0;
+}
+
+BatchStats batch_stats(void) {
+    return stats;
+}
+
+bool batch_visible_circle(const Camera *cam, f32 sx, f32 sy, f32 r) {
+    bool visible = screen_circle_visible(cam, sx, sy, r);
+    if (visible) stats.drawn++;
+    else         stats.culled++;
+    return visible;
+}
+
+bool batch_visible_segment(const Camera *cam, f32 x0, f32 y0, f32 x1, f32 y1, f32 pad) {
+    bool visible = screen_segment_visible(cam, x0, y0, x1, y1, pad);
+    if (visible) stats.drawn++;
+    else         stats.culled++;
+    return visible;
+}
+
+void batch_set_blend(SDL_BlendMode mode) {
+    if (mode == cur_blend) return;
+    batch_flush();
+    cur_blend = mode;
+}
+
+SDL_Vertex *batch_reserve(SDL_Texture *texture, int num_verts, int num_indices,
+                          int **out_indices, int *base_vertex) {
+    if (num_verts > BATCH_MAX_VERTS || num_indices > BATCH_MAX_INDICES)
+        return NULL;
+
+    if (texture != cur_texture) {
+        batch_flush();
+        cur_texture = texture;
+    }
+    if (vert_count + num_verts > BATCH_MAX_VERTS ||
+        index_count + num_indices > BATCH_MAX_INDICES)
+        batch_flush();
+
+    SDL_Vertex *v = &verts[vert_count];
+    *out_indices = &indices[index_count];
+    *base_vertex = vert_count;
+    vert_count  += num_verts;
+    index_count += num_indices;
+    return v;
+}
+
+static inline void set_vert(SDL_Vertex *v, f32 x, f32 y, SDL_FColor color) {
+    v->position  = (SDL_FPoint){ x, y };
+    v->color     = color;
+    v->tex_coord = (SDL_FPoint){ 0, 0 };
+}
+
+void batch_triangle(f32 x0, f32 y0, f32 x1, f32 y1, f32 x2, f32 y2, SDL_FColor color) {
+    int *idx, base;
+    SDL_Vertex *v = batch_reserve(NULL, 3, 3, &idx, &base);
+    if (!v) return;
+
+    set_vert(&v[0], x0, y0, color);
+    set_vert(&v[1], x1, y1, color);
+    set_vert(&v[2], x2, y2, color);
+    idx[0] = base;
+    idx[1] = base + 1;
+    idx[2] = base + 2;
+}
+
+void batch_line(f32 x0, f32 y0, f32 x1, f32 y1, f32 thickness, SDL_FColor color) {
+    f32 dx = x1 - x0;
+    f32 dy = y1 - y0;
+    f32 len = sqrtf(dx * dx + dy * dy);
+    if (len < 0.001f) return;
+
+    // Perpendicular offset
+    f32 half = thickness * 0.5f;
+    f32 px = -dy / len * half;
+    f32 py =  dx / len * half;
+
+    int *idx, base;
+    SDL_Vertex *v = batch_reserve(NULL, 4, 6, &idx, &base);
+    if (!v) return;
+
+    set_vert(&v[0], x0 + px, y0 + py, color);
+    set_vert(&v[1], x0 - px, y0 - py, color);
+    set_vert(&v[2], x1 + px, y1 + py, color);
+    set_vert(&v[3], x1 - px, y1 - py, color);
+
+    idx[0] = base;     idx[1] = base + 1; idx[2] = base + 2;
+    idx[3] = base + 1; idx[4] = base + 3; idx[5] = base + 2;
+}
+
+void batch_ring(f32 cx, f32 cy, f32 inner_r, f32 outer_r, s32 segments, SDL_FColor color) {
+    if (segments < 3) segments = 3;
+
+    int *idx, base;
+    SDL_Vertex *v = batch_reserve(NULL, (segments + 1) * 2, segments * 6, &idx, &base);
+    if (!v) return;
+
+    f32 step = 2.0f * (f32)M_PI / segments;
+    for (s32 i = 0; i <= segments; i++) {
+        f32 a = step * i;
+        f32 ca = cosf(a);
+        f32 sa = sinf(a);
+
+        // Outer, inner
+        set_vert(v++, cx + outer_r * ca, cy + outer_r * sa, color);
+        set_vert(v++, cx + inner_r * ca, cy + inner_r * sa, color);
+
+        if (i < segments) {
+            int b = base + i * 2;
+            // outer[i], inner[i], outer[i+1] / inner[i], inner[i+1], outer[i+1]
+            *idx++ = b;     *idx++ = b + 1; *idx++ = b + 2;
+            *idx++ = b + 1; *idx++ = b + 3; *idx++ = b + 2;
+        }
+    }
+}
+
+s32 batch_ring_segments(f32 radius_px) {
+    // Sagitta r * (1 - cos(pi / n)) <= tolerance
+    const f32 tolerance = 0.25f;
+    if (radius_px <= tolerance * 2.0f) return 8;
+    f32 n = (f32)M_PI / acosf(1.0f - tolerance / radius_px);
+    return CLAMP((s32)ceilf(n), 8, 256);
+}
+
+void batch_circle(f32 cx, f32 cy, f32 r, s32 segments, SDL_FColor color) {
+    if (segments < 3) segments = 3;
+
+    int *idx, base;
+    SDL_Vertex *v = batch_reserve(NULL, segments + 1, segments * 3, &idx, &base);
+    if (!v) return;
+
+    // Triangle fan around the center vertex
+    set_vert(v++, cx, cy, color);
+    f32 step = 2.0f * (f32)M_PI / segments;
+    for (s32 i = 0; i < segments; i++) {
+        f32 a = step * i;
+        set_vert(v++, cx + r * cosf(a), cy + r * sinf(a), color);
+        *idx++ = base;
+        *idx++ = base + 1 + i;
+        *idx++ = base + 1 + (i + 1) % segments;
+    }
+}
+
+void batch_sprite(SDL_Texture *texture, const SDL_FRect *src_uv,
+                  f32 cx, f32 cy, f32 half_w, f32 half_h,
+                  f32 angle_deg, SDL_FColor color) {
+    int *idx, base;
+    SDL_Vertex *v = batch_reserve(texture, 4, 6, &idx, &base);
+    if (!v) return;
+
+    SDL_FRect uv = src_uv ? *src_uv : (SDL_FRect){ 0, 0, 1, 1 };
+    f32 rad = angle_deg * (f32)M_PI / 180.0f;
+    f32 c = cosf(rad);
+    f32 s = sinf(rad);
+
+    // Corners TL, TR, BR, BL; y-down, so a positive angle turns clockwise
+    const f32 ox[4] = { -half_w,  half_w, half_w, -half_w };
+    const f32 oy[4] = { -half_h, -half_h, half_h,  half_h };
+    const f32 u[4]  = { uv.x, uv.x + uv.w, uv.x + uv.w, uv.x };
+    const f32 w[4]  = { uv.y, uv.y, uv.y + uv.h, uv.y + uv.h };
+
+    for (int i = 0; i < 4; i++) {
+        v[i].position  = (SDL_FPoint){ cx + ox[i] * c - oy[i] * s,
+                                       cy + ox[i] * s + oy[i] * c };
+        v[i].color     = color;
+        v[i].tex_coord = (SDL_FPoint){ u[i], w[i] };
+    }
+
+    idx[0] = base;     idx[1] = base + 1; idx[2] = base + 2;
+    idx[3] = base;     idx[4] = base + 2; idx[5] = base + 3;
+}
+
+void batch_submit_triangles(SDL_BlendMode blend, const SDL_FPoint *xy,
+                            const SDL_FColor *colors, s32 num_verts) {
+    batch_flush();
+    if (!batch_renderer || num_verts < 3) return;
+
+    SDL_BlendMode prev = SDL_BLENDMODE_NONE;
+    SDL_GetRenderDrawBlendMode(batch_renderer, &prev);
+    SDL_SetRenderDrawBlendMode(batch_renderer, blend);
+    SDL_RenderGeometryRaw(batch_renderer, NULL,
+                          (const float *)xy, sizeof(SDL_FPoint),
+                          colors, sizeof(SDL_FColor),
+                          NULL, 0, num_verts, NULL, 0, 0);
+    SDL_SetRenderDrawBlendMode(batch_renderer, prev);
+
+    stats.draw_calls++;
+    stats.vertices += num_verts;
+}
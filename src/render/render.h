@@ -1,8 +1,91 @@
 #pragma once
 
+#include <SDL3/SDL.h>
+#include "utils/q_util.h"
+#include "game/game.h"
+
 #include "render/render_background.h"
 #include "render/render_bounds.h"
 #include "render/render_ship.h"
+#include "render/render_trails.h"
+#include "render/render_particles.h"
 #include "render/render_planets.h"
 #include "render/render_ui.h"
 #include "render/render_field.h"
+#include "render/render_static.h"
+#include "render/render_heatmap.h"
+#include "render/render_scale.h"
+
+// ---------------------------------------------------------------------------
+// Frame-wide geometry batcher (render.c)
+//
+// All colored triangles, lines and textured sprites go into one vertex/index
+// stream. The stream is submitted with a single SDL_RenderGeometry call per
+// run of identical (texture, blend mode) state, so a frame that alternates
+// state only a few times costs only a few draw calls. Anything that draws
+// through SDL directly must call batch_flush() first to keep ordering.
+// ---------------------------------------------------------------------------
+
+#define BATCH_MAX_VERTS   32768
+#define BATCH_MAX_INDICES (BATCH_MAX_VERTS * 3 / 2)
+
+typedef struct {
+    s32 draw_calls;   // SDL_RenderGeometry submissions
+    s32 vertices;
+    s32 indices;
+    s32 drawn;        // objects that passed batch_visible_* culling
+    s32 culled;       // objects skipped as off-screen
+} BatchStats;
+
+static inline SDL_FColor color_u8(u8 r, u8 g, u8 b, u8 a) {
+    return (SDL_FColor){ r / 255.0f, g / 255.0f, b / 255.0f, a / 255.0f };
+}
+
+// Bind the renderer and reset per-frame stats (blend defaults to BLEND)
+void batch_begin(SDL_Renderer *renderer);
+// Submit everything queued so far
+void batch_flush(void);
+// Stats for the frame since the last batch_begin
+BatchStats batch_stats(void);
+
+void batch_set_blend(SDL_BlendMode mode);
+
+// Screen-space visibility against the camera viewport. `r` / `pad` are in
+// pixels and should cover everything drawn around the object (glow, outline).
+static inline bool screen_circle_visible(const Camera *cam, f32 sx, f32 sy, f32 r) {
+    return sx + r >= 0.0f && sy + r >= 0.0f &&
+           sx - r <= (f32)cam->screen_w && sy - r <= (f32)cam->screen_h;
+}
+
+static inline bool screen_segment_visible(const Camera *cam, f32 x0, f32 y0,
+                                          f32 x1, f32 y1, f32 pad) {
+    return MAX(x0, x1) + pad >= 0.0f && MAX(y0, y1) + pad >= 0.0f &&
+           MIN(x0, x1) - pad <= (f32)cam->screen_w && MIN(y0, y1) - pad <= (f32)cam->screen_h;
+}
+
+// The same tests, tallied into the frame's drawn/culled counters
+bool batch_visible_circle(const Camera *cam, f32 sx, f32 sy, f32 r);
+bool batch_visible_segment(const Camera *cam, f32 x0, f32 y0, f32 x1, f32 y1, f32 pad);
+
+// Reserve space for raw geometry under `texture`; returns the first vertex
+// and writes the first index slot. Indices must be offset by *base_vertex.
+SDL_Vertex *batch_reserve(SDL_Texture *texture, int num_verts, int num_indices,
+                          int **indices, int *base_vertex);
+
+void batch_triangle(f32 x0, f32 y0, f32 x1, f32 y1, f32 x2, f32 y2, SDL_FColor color);
+// Line segment as a quad `thickness` pixels wide
+void batch_line(f32 x0, f32 y0, f32 x1, f32 y1, f32 thickness, SDL_FColor color);
+// Filled annulus tessellated into `segments` slices
+void batch_ring(f32 cx, f32 cy, f32 inner_r, f32 outer_r, s32 segments, SDL_FColor color);
+// Segment count keeping a circle of `radius_px` within ~0.25 px of true
+s32 batch_ring_segments(f32 radius_px);
+void batch_circle(f32 cx, f32 cy, f32 r, s32 segments, SDL_FColor color);
+// Textured quad centered on (cx, cy), rotated clockwise by `angle_deg`
+void batch_sprite(SDL_Texture *texture, const SDL_FRect *src_uv,
+                  f32 cx, f32 cy, f32 half_w, f32 half_h,
+                  f32 angle_deg, SDL_FColor color);
+// Flush, then submit an untextured triangle list (3 vertices per triangle)
+// from caller-owned arrays in one call; for geometry too large to stage
+// through the batch. Counted in the frame stats.
+void batch_submit_triangles(SDL_BlendMode blend, const SDL_FPoint *xy,
+                            const SDL_FColor *colors, s32 num_verts);
@@ -1,118 +1,114 @@
 #include "render/render_background.h"
+#include "render/render.h"
 #include <math.h>
-#include <stdlib.h>
-#include <string.h>
 
-#define SCREEN_W 1280
-#define SCREEN_H 720
-
-#define NUM_LAYERS 3
-#define STARS_PER_LAYER 60
+#define NUM_LAYERS      3
+#define STARS_PER_LAYER 60      // at the 1280x720 reference area
+#define STAR_POOL       256     // per layer; caps density on huge outputs
+#define REF_AREA        (1280.0f * 720.0f)
+#define STAR_SEED       0x5EED57A2u
 
 typedef struct {
-    SDL_Texture *texture;
-    f32  speed;      // pixels per second (vertical scroll)
+    f32 u[STAR_POOL];   // normalized [0, 1) position
+    f32 v[STAR_POOL];
+    f32 speed;          // pixels per second (vertical scroll)
+    f32 size;           // square size in pixels
+    SDL_FColor color;
 } StarLayer;
 
 static StarLayer layers[NUM_LAYERS];
 static bool initialized = false;
 static u64 start_counter = 0;  // absolute time origin for scroll
 
-static f32 randf(void) {
-    return (f32)rand() / (f32)RAND_MAX;
-}
-
-// Stamp a star (filled square) into an RGBA pixel buffer
-static void stamp_star(u32 *pixels, int pitch_pixels,
-                        int cx, int cy, int size,
-                        u8 r, u8 g, u8 b) {
-    int half = size / 2;
-    for (int dy = -half; dy < size - half; dy++) {
-        int py = cy + dy;
-        if (py < 0 || py >= SCREEN_H) continue;
-        for (int dx = -half; dx < size - half; dx++) {
-            int px = cx + dx;
-            if (px < 0 || px >= SCREEN_W) continue;
-            // RGBA8888: R in low byte
-            pixels[py * pitch_pixels + px] = (u32)r | ((u32)g << 8) | ((u32)b << 16) | (0xFFu << 24);
-        }
-    }
+// xorshift32: the field is a pure function of the seed
+static f32 next_unit(u32 *state) {
+    u32 x = *state;
+    x ^= x << 13;
+    x ^= x >> 17;
+    x ^= x << 5;
+    *state = x;
+    return (f32)(x >> 8) * (1.0f / 16777216.0f);
 }
 
-void background_init(SDL_Renderer *renderer) {
+void background_init(u32 seed) {
     const f32 speeds[] = { 15.0f, 35.0f, 70.0f };
-    const int sizes[]  = {     1,     2,     3 };
+    const f32 sizes[]  = {  1.0f,  2.0f,  3.0f };
     const u8  brights[] = {   80,   140,   220 };
 
+    u32 rng = seed ? seed : STAR_SEED;
     for (int l = 0; l < NUM_LAYERS; l++) {
-        layers[l].speed  = speeds[l];
+        StarLayer *layer = &layers[l];
+        layer->speed = speeds[l];
+        layer->size  = sizes[l];
 
         // Compute layer color (same tint formula as before)
         u8 bright = brights[l];
         u8 cr = (u8)(bright * (0.7f + 0.3f * ((f32)l / (NUM_LAYERS - 1))));
         u8 cg = (u8)(bright * (0.8f + 0.2f * ((f32)l / (NUM_LAYERS - 1))));
-        u8 cb = bright;
-
-        // Create streaming texture with alpha
-        layers[l].texture = SDL_CreateTexture(renderer,
-            SDL_PIXELFORMAT_ABGR8888, SDL_TEXTUREACCESS_STREAMING,
-            SCREEN_W, SCREEN_H);
-        SDL_SetTextureBlendMode(layers[l].texture, SDL_BLENDMODE_BLEND);
-        SDL_SetTextureScaleMode(layers[l].texture, SDL_SCALEMODE_NEAREST);
-
-        // Lock, clear to transparent, stamp stars, unlock
-        void *raw_pixels;
-        int pitch;
-        SDL_LockTexture(layers[l].texture, NULL, &raw_pixels, &pitch);
-
-        int pitch_pixels = pitch / 4;
-        u32 *pixels = (u32 *)raw_pixels;
-        memset(pixels, 0, (size_t)pitch * SCREEN_H);  // fully transparent
-
-        for (int i = 0; i < STARS_PER_LAYER; i++) {
-            int sx = (int)(randf() * SCREEN_W);
-            int sy = (int)(randf() * SCREEN_H);
-            stamp_star(pixels, pitch_pixels, sx, sy, sizes[l], cr, cg, cb);
-        }
+        layer->color = color_u8(cr, cg, bright, 255);
 
-        SDL_UnlockTexture(layers[l].texture);
+        for (int i = 0; i < STAR_POOL; i++) {
+            layer->u[i] = next_unit(&rng);
+            layer->v[i] = next_unit(&rng);
+        }
     }
 
     start_counter = SDL_GetPerformanceCounter();
     initialized = true;
 }
 
-void background_shutdown(void) {
-    for (int l = 0; l < NUM_LAYERS; l++) {
-        if (layers[l].texture) {
-            SDL_DestroyTexture(layers[l].texture);
-            layers[l].texture = NULL;
-        }
-    }
-    initialized = false;
-}
-
+// Queues into the frame batch: all layers are one untextured draw.
 void render_background(SDL_Renderer *renderer, f32 dt) {
     (void)dt;
-    if (!initialized) background_init(renderer);
+    if (!initialized) background_init(STAR_SEED);
+
+    // Output size in drawing coordinates (points when the target is scaled)
+    int out_w = 0, out_h = 0;
+    f32 scale_x = 1.0f, scale_y = 1.0f;
+    SDL_GetCurrentRenderOutputSize(renderer, &out_w, &out_h);
+    SDL_GetRenderScale(renderer, &scale_x, &scale_y);
+    if (out_w <= 0 || out_h <= 0 || scale_x <= 0.0f || scale_y <= 0.0f) return;
+    f32 w = (f32)out_w / scale_x;
+    f32 h = (f32)out_h / scale_y;
+
+    // Keep star density constant as the output grows or shrinks
+    s32 count = (s32)(STARS_PER_LAYER * (w * h) / REF_AREA + 0.5f);
+    count = CLAMP(count, 1, STAR_POOL);
 
     // Compute elapsed time from absolute clock — no dt accumulation jitter
     f32 elapsed = (f32)(SDL_GetPerformanceCounter() - start_counter)
                 / (f32)SDL_GetPerformanceFrequency();
 
+    batch_set_blend(SDL_BLENDMODE_BLEND);
     for (int l = 0; l < NUM_LAYERS; l++) {
-        StarLayer *layer = &layers[l];
+        const StarLayer *layer = &layers[l];
 
         // Scroll position derived from absolute time (wraps seamlessly)
-        f32 offset = fmodf(elapsed * layer->speed, (f32)SCREEN_H);
-
-        // Draw the texture twice to wrap seamlessly:
-        // Top portion: the part that has scrolled down
-        SDL_FRect dst_top = { 0, offset, (f32)SCREEN_W, (f32)SCREEN_H };
-        SDL_RenderTexture(renderer, layer->texture, NULL, &dst_top);
-
-        // Wrapped copy above it
-        SDL_FRect dst_wrap = { 0, offset - (f32)SCREEN_H, (f32)SCREEN_W, (f32)SCREEN_H };
-        SDL_RenderTexture(renderer, layer->texture, NULL, &dst_wrap);
+        f32 offset = fmodf(elapsed * layer->speed, h);
+        f32 half = layer->size * 0.5f;
+
+        int *idx, base;
+        SDL_Vertex *v = batch_reserve(NULL, count * 4, count * 6, &idx, &base);
+        if (!v) return;
+
+        for (s32 i = 0; i < count; i++) {
+            // Snap to whole pixels so 1 px stars stay crisp
+            f32 x = floorf(layer->u[i] * w);
+            f32 y = layer->v[i] * h + offset;
+            if (y >= h) y -= h;
+            y = floorf(y);
+
+            f32 x0 = x - floorf(half), y0 = y - floorf(half);
+            f32 x1 = x0 + layer->size, y1 = y0 + layer->size;
+            v[0] = (SDL_Vertex){ { x0, y0 }, layer->color, { 0, 0 } };
+            v[1] = (SDL_Vertex){ { x1, y0 }, layer->color, { 0, 0 } };
+            v[2] = (SDL_Vertex){ { x1, y1 }, layer->color, { 0, 0 } };
+            v[3] = (SDL_Vertex){ { x0, y1 }, layer->color, { 0, 0 } };
+            v += 4;
+
+            int b = base + i * 4;
+            *idx++ = b;     *idx++ = b + 1; *idx++ = b + 2;
+            *idx++ = b;     *idx++ = b + 2; *idx++ = b + 3;
+        }
     }
 }
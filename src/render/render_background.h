@@ -3,6 +3,6 @@
 #include <SDL3/SDL.h>
 #include "utils/q_util.h"
 
-void background_init(SDL_Renderer *renderer);
-void background_shutdown(void);
+// Seeded parallax star field (0 = default seed). Cheap; call at startup.
+void background_init(u32 seed);
 void render_background(SDL_Renderer *renderer, f32 dt);
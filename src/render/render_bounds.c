@@ -1,6 +1,8 @@
 #include "render/render_bounds.h"
+#include "render/render.h"
 
 void render_bounds(SDL_Renderer *renderer, const Game *game) {
+    (void)renderer;
     const Camera *cam = &game->cam;
 
     f32 x0 = world_to_screen_x(cam, game->bounds_min.x);
@@ -8,13 +10,11 @@ void render_bounds(SDL_Renderer *renderer, const Game *game) {
     f32 x1 = world_to_screen_x(cam, game->bounds_max.x);
     f32 y1 = world_to_screen_y(cam, game->bounds_min.y); // min y = bottom of screen
 
-    SDL_SetRenderDrawBlendMode(renderer, SDL_BLENDMODE_BLEND);
-    SDL_SetRenderDrawColor(renderer, 255, 60, 60, 100);
+    SDL_FColor color = color_u8(255, 60, 60, 100);
 
-    SDL_RenderLine(renderer, x0, y0, x1, y0); // top
-    SDL_RenderLine(renderer, x1, y0, x1, y1); // right
-    SDL_RenderLine(renderer, x1, y1, x0, y1); // bottom
-    SDL_RenderLine(renderer, x0, y1, x0, y0); // left
-
-    SDL_SetRenderDrawBlendMode(renderer, SDL_BLENDMODE_NONE);
+    batch_set_blend(SDL_BLENDMODE_BLEND);
+    batch_line(x0, y0, x1, y0, 1.0f, color); // top
+    batch_line(x1, y0, x1, y1, 1.0f, color); // right
+    batch_line(x1, y1, x0, y1, 1.0f, color); // bottom
+    batch_line(x0, y1, x0, y0, 1.0f, color); // left
 }
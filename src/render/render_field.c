@@ -1,67 +1,50 @@
 #include "render/render_field.h"
+#include "render/render.h"
 #include "physics/phys_gravity.h"
 #include <math.h>
 
-#define FIELD_SPACING    2.0f   // world units between sample points
+#define FIELD_SPACING    2.0f   // base world units between sample points
+#define LOD_MIN_LEVEL   -3      // finest grid: FIELD_SPACING / 8
+#define LOD_MAX_LEVEL   12
+#define MIN_SPACING_PX  32.0f   // keep arrows from overlapping when zoomed in
+#define ARROW_BUDGET    1200    // target arrows on screen at any zoom
 #define ARROW_MIN_LEN    6.0f   // minimum arrow length in pixels
 #define ARROW_MAX_LEN   28.0f   // maximum arrow length in pixels
 #define ARROW_HEAD      6.0f    // arrowhead barb length in pixels
 #define MAG_CLAMP        8.0f   // accel magnitude that maps to max length
 
-// Each arrow: shaft quad (4v, 6i) + 2 barb quads (4v, 6i each) = 12 verts, 18 indices
-// Budget for ~2000 arrows
+// Hard cap on arrows per frame (each is 3 quads in the batch)
 #define MAX_ARROWS 2000
-#define MAX_VERTS  (MAX_ARROWS * 12)
-#define MAX_INDICES (MAX_ARROWS * 18)
-
-static SDL_Vertex verts[MAX_VERTS];
-static int indices[MAX_INDICES];
-
-// Append a thin quad (line segment with thickness) to the batch
-static inline void push_quad(int *vi, int *ii,
-                              f32 x0, f32 y0, f32 x1, f32 y1,
-                              f32 thickness, SDL_FColor color) {
-    f32 dx = x1 - x0;
-    f32 dy = y1 - y0;
-    f32 len = sqrtf(dx * dx + dy * dy);
-    if (len < 0.001f) return;
-
-    // Perpendicular offset
-    f32 half = thickness * 0.5f;
-    f32 px = -dy / len * half;
-    f32 py =  dx / len * half;
-
-    int base = *vi;
-
-    verts[base + 0].position = (SDL_FPoint){ x0 + px, y0 + py };
-    verts[base + 0].color = color;
-    verts[base + 0].tex_coord = (SDL_FPoint){ 0, 0 };
-
-    verts[base + 1].position = (SDL_FPoint){ x0 - px, y0 - py };
-    verts[base + 1].color = color;
-    verts[base + 1].tex_coord = (SDL_FPoint){ 0, 0 };
-
-    verts[base + 2].position = (SDL_FPoint){ x1 + px, y1 + py };
-    verts[base + 2].color = color;
-    verts[base + 2].tex_coord = (SDL_FPoint){ 0, 0 };
-
-    verts[base + 3].position = (SDL_FPoint){ x1 - px, y1 - py };
-    verts[base + 3].color = color;
-    verts[base + 3].tex_coord = (SDL_FPoint){ 0, 0 };
-
-    int idx = *ii;
-    indices[idx + 0] = base;
-    indices[idx + 1] = base + 1;
-    indices[idx + 2] = base + 2;
-    indices[idx + 3] = base + 1;
-    indices[idx + 4] = base + 3;
-    indices[idx + 5] = base + 2;
-
-    *vi += 4;
-    *ii += 6;
+
+// Grid spacing for the current view: FIELD_SPACING * 2^k with the smallest
+// k that keeps arrows MIN_SPACING_PX apart and within ARROW_BUDGET. Powers
+// of two nest, so every coarser grid is a subset of the finer one and
+// arrows don't shimmer as the zoom crosses a level.
+static f32 field_spacing(const Camera *cam, f32 view_w, f32 view_h) {
+    f32 spacing = ldexpf(FIELD_SPACING, LOD_MIN_LEVEL);
+    for (int k = LOD_MIN_LEVEL; k < LOD_MAX_LEVEL; k++) {
+        f32 count = (view_w / spacing + 1.0f) * (view_h / spacing + 1.0f);
+        if (spacing * cam->ppm >= MIN_SPACING_PX && count <= ARROW_BUDGET)
+            break;
+        spacing *= 2.0f;
+    }
+    return spacing;
+}
+
+// Mean acceleration over the cell centered on (wx, wy): one 2x2 stratified
+// sample set, evaluated as a single 4-wide batch.
+static Vec2 cell_average_accel(const GravitySources *src, f32 wx, f32 wy, f32 spacing) {
+    f32 q = spacing * 0.25f;
+    f32 xs[4] = { wx - q, wx + q, wx - q, wx + q };
+    f32 ys[4] = { wy - q, wy - q, wy + q, wy + q };
+    f32 ax[4], ay[4];
+    gravity_field_batch(src, xs, ys, 4, ax, ay, NULL);
+    return (Vec2){ (ax[0] + ax[1] + ax[2] + ax[3]) * 0.25f,
+                   (ay[0] + ay[1] + ay[2] + ay[3]) * 0.25f };
 }
 
 void render_gravity_field(SDL_Renderer *renderer, const Game *game) {
+    (void)renderer;
     const Camera *cam = &game->cam;
 
     // Visible world bounds from screen corners
@@ -75,19 +58,27 @@ void render_gravity_field(SDL_Renderer *renderer, const Game *game) {
         f32 t = world_bottom; world_bottom = world_top; world_top = t;
     }
 
-    // Snap to grid
-    f32 x_start = floorf(world_left  / FIELD_SPACING) * FIELD_SPACING;
-    f32 y_start = floorf(world_bottom / FIELD_SPACING) * FIELD_SPACING;
+    f32 spacing = field_spacing(cam, world_right - world_left, world_top - world_bottom);
+
+    // Integer grid indices so points land on exact multiples of spacing
+    s32 ix0 = (s32)floorf(world_left / spacing);
+    s32 ix1 = (s32)ceilf(world_right / spacing);
+    s32 iy0 = (s32)floorf(world_bottom / spacing);
+    s32 iy1 = (s32)ceilf(world_top / spacing);
 
-    int vi = 0, ii = 0;
+    GravitySources src;
+    gravity_sources_build(&src, game->planets, game->planet_count);
 
-    for (f32 wy = y_start; wy <= world_top; wy += FIELD_SPACING) {
-        for (f32 wx = x_start; wx <= world_right; wx += FIELD_SPACING) {
-            // Check buffer capacity (need up to 12 verts, 18 indices per arrow)
-            if (vi + 12 > MAX_VERTS) goto flush;
+    int arrows = 0;
+    batch_set_blend(SDL_BLENDMODE_BLEND);
 
-            Vec2 pos = { wx, wy };
-            Vec2 accel = gravity_accel(pos, game->planets, game->planet_count);
+    for (s32 iy = iy0; iy <= iy1; iy++) {
+        for (s32 ix = ix0; ix <= ix1; ix++) {
+            if (arrows >= MAX_ARROWS) return;
+
+            f32 wx = ix * spacing;
+            f32 wy = iy * spacing;
+            Vec2 accel = cell_average_accel(&src, wx, wy, spacing);
 
             f32 mag = vec2_len(accel);
             if (mag < 1e-4f) continue;
@@ -119,8 +110,10 @@ void render_gravity_field(SDL_Renderer *renderer, const Game *game) {
                 (100.0f + t * 120.0f) / 255.0f
             };
 
+            arrows++;
+
             // Shaft quad (1px thickness)
-            push_quad(&vi, &ii, sx, sy, ex, ey, 1.0f, color);
+            batch_line(sx, sy, ex, ey, 1.0f, color);
 
             // Arrowhead barbs
             f32 screen_len = sqrtf(dx * dx + dy * dy);
@@ -131,16 +124,9 @@ void render_gravity_field(SDL_Renderer *renderer, const Game *game) {
                 f32 ay1 = ey - uy * ARROW_HEAD - ux * ARROW_HEAD * 0.5f;
                 f32 ax2 = ex - ux * ARROW_HEAD - uy * ARROW_HEAD * 0.5f;
                 f32 ay2 = ey - uy * ARROW_HEAD + ux * ARROW_HEAD * 0.5f;
-                push_quad(&vi, &ii, ex, ey, ax1, ay1, 1.0f, color);
-                push_quad(&vi, &ii, ex, ey, ax2, ay2, 1.0f, color);
+                batch_line(ex, ey, ax1, ay1, 1.0f, color);
+                batch_line(ex, ey, ax2, ay2, 1.0f, color);
             }
         }
     }
-
-flush:
-    if (vi > 0) {
-        SDL_SetRenderDrawBlendMode(renderer, SDL_BLENDMODE_BLEND);
-        SDL_RenderGeometry(renderer, NULL, verts, vi, indices, ii);
-        SDL_SetRenderDrawBlendMode(renderer, SDL_BLENDMODE_NONE);
-    }
 }
@@ -0,0 +1,158 @@
+#include "render/render_heatmap.h"
+#include "render/render.h"
+#include "physics/phys_gravity.h"
+#include "utils/jobs.h"
+#include "utils/profiler.h"
+#include <math.h>
+
+#define ACCEL_REF      8.0f    // |a| that maps to mid-scale
+#define POTENTIAL_REF 40.0f    // -φ that maps to mid-scale
+#define ROW_SPAN      256      // points per batch call (bounds stack use)
+
+static u32  palette[256];
+static bool palette_ready;
+
+static u64  cached_key;
+static bool cached_valid;
+static s32  cached_w, cached_h;
+
+typedef struct {
+    GravitySources src;
+    const Camera  *cam;
+    HeatmapMode    mode;
+    s32            divisor;
+    s32            w;
+    u8            *pixels;
+    int            pitch;
+} HeatmapJob;
+
+// Dark violet -> magenta -> orange -> pale yellow, alpha rising with value
+static void build_palette(void) {
+    static const f32 stops[][5] = {
+        // t,     r,    g,    b,    a
+        { 0.00f,   0,    0,   20,    0 },
+        { 0.25f,  60,   10,  110,   70 },
+        { 0.50f, 170,   40,  110,  120 },
+        { 0.75f, 245,  130,   30,  160 },
+        { 1.00f, 255,  245,  170,  200 },
+    };
+    for (int i = 0; i < 256; i++) {
+        f32 t = i / 255.0f;
+        int s = 0;
+        while (s < ARRAY_LEN(stops) - 2 && t > stops[s + 1][0]) s++;
+        f32 u = (t - stops[s][0]) / (stops[s + 1][0] - stops[s][0]);
+        u8 c[4];
+        for (int k = 0; k < 4; k++)
+            c[k] = (u8)(stops[s][k + 1] + u * (stops[s + 1][k + 1] - stops[s][k + 1]));
+        // ABGR8888: R in the low byte
+        palette[i] = (u32)c[0] | ((u32)c[1] << 8) | ((u32)c[2] << 16) | ((u32)c[3] << 24);
+    }
+    palette_ready = true;
+}
+
+static u64 field_hash(const Game *game, HeatmapMode mode, s32 divisor) {
+    const Camera *cam = &game->cam;
+    u64 h = FNV1A64_SEED;
+    h = fnv1a64_f32(h, (f32)mode);
+    h = fnv1a64_f32(h, (f32)divisor);
+    h = fnv1a64_f32(h, cam->ppm);
+    h = fnv1a64_f32(h, cam->cam_x);
+    h = fnv1a64_f32(h, cam->cam_y);
+    h = fnv1a64_f32(h, (f32)cam->screen_w);
+    h = fnv1a64_f32(h, (f32)cam->screen_h);
+    for (s32 i = 0; i < game->planet_count; i++) {
+        const Planet *p = &game->planets[i];
+        h = fnv1a64_f32(h, p->pos.x);
+        h = fnv1a64_f32(h, p->pos.y);
+        h = fnv1a64_f32(h, p->mu);
+        h = fnv1a64_f32(h, p->eps);
+    }
+    return h;
+}
+
+static void heatmap_rows(void *ctx, s32 begin, s32 end) {
+    const HeatmapJob *job = ctx;
+    const Camera *cam = job->cam;
+    f32 xs[ROW_SPAN], ys[ROW_SPAN], ax[ROW_SPAN], ay[ROW_SPAN], phi[ROW_SPAN];
+
+    for (s32 row = begin; row < end; row++) {
+        u32 *out = (u32 *)(job->pixels + (size_t)row * (size_t)job->pitch);
+        f32 wy = screen_to_world_y(cam, (row + 0.5f) * job->divisor);
+
+        for (s32 x0 = 0; x0 < job->w; x0 += ROW_SPAN) {
+            s32 n = MIN(ROW_SPAN, job->w - x0);
+            for (s32 i = 0; i < n; i++) {
+                xs[i] = screen_to_world_x(cam, (x0 + i + 0.5f) * job->divisor);
+                ys[i] = wy;
+            }
+
+            bool potential = job->mode == HEATMAP_POTENTIAL;
+            gravity_field_batch(&job->src, xs, ys, n, ax, ay, potential ? phi : NULL);
+
+            for (s32 i = 0; i < n; i++) {
+                f32 v, ref;
+                if (potential) {
+                    v = -phi[i];
+                    ref = POTENTIAL_REF;
+                } else {
+                    v = sqrtf(ax[i] * ax[i] + ay[i] * ay[i]);
+                    ref = ACCEL_REF;
+                }
+                // v / (v + ref): 0 at rest, 0.5 at ref, saturates smoothly
+                f32 t = v / (v + ref);
+                out[x0 + i] = palette[(int)(CLAMP(t, 0.0f, 1.0f) * 255.0f)];
+            }
+        }
+    }
+}
+
+void render_heatmap(SDL_Renderer *renderer, SDL_Texture *target,
+                    const Game *game, HeatmapMode mode, s32 divisor) {
+    (void)renderer;
+    if (!target) return;
+    if (!palette_ready) build_palette();
+
+    f32 tex_w = 0, tex_h = 0;
+    SDL_GetTextureSize(target, &tex_w, &tex_h);
+    divisor = MAX(divisor, 1);
+    s32 w = MIN((game->cam.screen_w + divisor - 1) / divisor, (s32)tex_w);
+    s32 h = MIN((game->cam.screen_h + divisor - 1) / divisor, (s32)tex_h);
+    if (w <= 0 || h <= 0) return;
+
+    u64 key = field_hash(game, mode, divisor);
+    if (!cached_valid || key != cached_key || w != cached_w || h != cached_h) {
+        PROF_BEGIN("heatmap_rebuild");
+        SDL_Rect rect = { 0, 0, w, h };
+        void *pixels;
+        int pitch;
+        if (SDL_LockTexture(target, &rect, &pixels, &pitch)) {
+            HeatmapJob job = {
+                .cam = &game->cam, .mode = mode, .divisor = divisor,
+                .w = w, .pixels = pixels, .pitch = pitch,
+            };
+            gravity_sources_build(&job.src, game->planets, game->planet_count);
+            jobs_parallel_for(h, 8, heatmap_rows, &job);
+            SDL_UnlockTexture(target);
+
+            cached_key = key;
+            cached_w = w;
+            cached_h = h;
+            cached_valid = true;
+        }
+        PROF_END();
+    }
+
+    SDL_SetTextureScaleMode(target, divisor > 1 ? SDL_SCALEMODE_LINEAR : SDL_SCALEMODE_NEAREST);
+
+    // Sub-rectangle in use, stretched over the (possibly uneven) screen
+    SDL_FRect uv = { 0, 0, w / tex_w, h / tex_h };
+    f32 half_w = w * divisor * 0.5f;
+    f32 half_h = h * divisor * 0.5f;
+    batch_set_blend(SDL_BLENDMODE_BLEND);
+    batch_sprite(target, &uv, half_w, half_h, half_w, half_h, 0.0f,
+                 (SDL_FColor){ 1.0f, 1.0f, 1.0f, 1.0f });
+}
+
+void heatmap_invalidate(void) {
+    cached_valid = false;
+}
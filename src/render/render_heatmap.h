@@ -0,0 +1,18 @@
+#pragma once
+
+#include <SDL3/SDL.h>
+#include "game/game.h"
+
+typedef enum {
+    HEATMAP_ACCEL,       // |a(x)|
+    HEATMAP_POTENTIAL,   // -φ(x)
+    HEATMAP_MODE_COUNT,
+} HeatmapMode;
+
+// Rasterize the gravity field into `target` (a streaming ABGR8888 texture)
+// at 1/`divisor` of the screen resolution and draw it over the whole
+// screen. The field is recomputed only when the camera, planets, mode or
+// divisor change.
+void render_heatmap(SDL_Renderer *renderer, SDL_Texture *target,
+                    const Game *game, HeatmapMode mode, s32 divisor);
+void heatmap_invalidate(void);
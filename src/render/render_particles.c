@@ -0,0 +1,243 @@
+#include "render/render_particles.h"
+#include "render/render.h"
+#include "utils/q_simd.h"
+#include <math.h>
+
+#define DRAG            1.5f     // velocity decay, 1/s
+#define EXHAUST_RATE    90.0f    // particles per second per flying ship
+#define EXHAUST_SPEED   3.0f     // m/s backwards, relative to the ship
+#define CRASH_COUNT     600
+#define LOST_COUNT      80
+#define ARRIVE_COUNT    240
+
+// Colour over a particle's life: lerped from `from` at spawn to `to` at death
+typedef enum {
+    RAMP_EXHAUST,
+    RAMP_CRASH,
+    RAMP_LOST,
+    RAMP_ARRIVE,
+    RAMP_COUNT,
+} RampId;
+
+typedef struct {
+    SDL_FColor from, to;
+} Ramp;
+
+static const Ramp ramps[RAMP_COUNT] = {
+    [RAMP_EXHAUST] = { { 1.00f, 0.85f, 0.50f, 0.70f }, { 1.00f, 0.30f, 0.05f, 0.0f } },
+    [RAMP_CRASH]   = { { 1.00f, 0.95f, 0.80f, 1.00f }, { 0.90f, 0.20f, 0.05f, 0.0f } },
+    [RAMP_LOST]    = { { 0.70f, 0.75f, 0.90f, 0.60f }, { 0.30f, 0.30f, 0.50f, 0.0f } },
+    [RAMP_ARRIVE]  = { { 0.60f, 1.00f, 0.70f, 0.90f }, { 0.20f, 0.70f, 1.00f, 0.0f } },
+};
+
+// Live particles occupy [0, count); the SIMD pass may touch up to the next
+// multiple of 4, which PARTICLE_CAPACITY being a multiple of 4 keeps in range.
+static struct {
+    _Alignas(16) f32 x[PARTICLE_CAPACITY];
+    _Alignas(16) f32 y[PARTICLE_CAPACITY];
+    _Alignas(16) f32 vx[PARTICLE_CAPACITY];
+    _Alignas(16) f32 vy[PARTICLE_CAPACITY];
+    _Alignas(16) f32 age[PARTICLE_CAPACITY];    // 0 at spawn, dead at 1
+    _Alignas(16) f32 rate[PARTICLE_CAPACITY];   // 1 / lifetime (s)
+    f32 size[PARTICLE_CAPACITY];                // pixels
+    u8  ramp[PARTICLE_CAPACITY];
+    s32 count;
+} pool;
+
+SDL_COMPILE_TIME_ASSERT(particle_capacity, PARTICLE_CAPACITY % F32X4_WIDTH == 0);
+
+// One triangle per particle
+static SDL_FPoint vert_xy[PARTICLE_CAPACITY * 3];
+static SDL_FColor vert_color[PARTICLE_CAPACITY * 3];
+
+static f32 exhaust_accum[MAX_FLEET];   // fractional particles carried over
+static u32 rng_state = 0x9e3779b9u;
+
+// xorshift32 in [0, 1); effects need no reproducibility
+static f32 frand(void) {
+    rng_state ^= rng_state << 13;
+    rng_state ^= rng_state >> 17;
+    rng_state ^= rng_state << 5;
+    return (f32)(rng_state >> 8) * (1.0f / 16777216.0f);
+}
+
+static f32 frange(f32 lo, f32 hi) {
+    return lo + (hi - lo) * frand();
+}
+
+static void spawn(f32 x, f32 y, f32 vx, f32 vy, f32 life, f32 size, RampId ramp) {
+    if (pool.count >= PARTICLE_CAPACITY) return;   // full: drop the spawn
+    s32 i = pool.count++;
+    pool.x[i]    = x;
+    pool.y[i]    = y;
+    pool.vx[i]   = vx;
+    pool.vy[i]   = vy;
+    pool.age[i]  = 0.0f;
+    pool.rate[i] = 1.0f / life;
+    pool.size[i] = size;
+    pool.ramp[i] = (u8)ramp;
+}
+
+// Radial burst around `pos`, inheriting some of the ship's velocity
+static void spawn_burst(const GameEvent *ev, s32 count, f32 max_speed,
+                        f32 min_life, f32 max_life, f32 min_size, f32 max_size,
+                        RampId ramp) {
+    for (s32 i = 0; i < count; i++) {
+        f32 a = frange(0.0f, 2.0f * (f32)M_PI);
+        // sqrt biases speeds outward so the burst reads as a filled disc
+        f32 speed = max_speed * sqrtf(frand());
+        spawn(ev->pos.x, ev->pos.y,
+              cosf(a) * speed + ev->vel.x * 0.25f,
+              sinf(a) * speed + ev->vel.y * 0.25f,
+              frange(min_life, max_life), frange(min_size, max_size), ramp);
+    }
+}
+
+static void spawn_events(const Game *game) {
+    const PhysState *ps = &game->phys;
+    for (s32 i = 0; i < ps->event_count; i++) {
+        const GameEvent *ev = &ps->events[i];
+        switch (ev->type) {
+        case GAME_EVENT_SHIP_CRASHED:
+            spawn_burst(ev, CRASH_COUNT, 8.0f, 0.5f, 1.4f, 1.5f, 3.5f, RAMP_CRASH);
+            break;
+        case GAME_EVENT_SHIP_LOST:
+            spawn_burst(ev, LOST_COUNT, 2.0f, 0.4f, 0.8f, 1.0f, 2.0f, RAMP_LOST);
+            break;
+        case GAME_EVENT_SHIP_ARRIVED:
+            // Ring rather than disc: every spark at nearly the same speed
+            for (s32 k = 0; k < ARRIVE_COUNT; k++) {
+                f32 a = (f32)k * (2.0f * (f32)M_PI / ARRIVE_COUNT);
+                f32 speed = frange(2.6f, 3.2f);
+                spawn(ev->pos.x, ev->pos.y, cosf(a) * speed, sinf(a) * speed,
+                      frange(0.8f, 1.2f), frange(1.5f, 2.5f), RAMP_ARRIVE);
+            }
+            break;
+        }
+    }
+}
+
+static void spawn_exhaust(const Game *game, f32 dt) {
+    if (game->state != GAME_STATE_PLAYING) {
+        SDL_memset(exhaust_accum, 0, sizeof(exhaust_accum));
+        return;
+    }
+
+    const Camera *cam = &game->cam;
+    for (s32 i = 0; i < game->fleet_count; i++) {
+        const Ship *ship = &game->ships[i];
+        if (!ship->alive || ship->arrived) continue;
+
+        exhaust_accum[i] += EXHAUST_RATE * dt;
+        s32 n = (s32)exhaust_accum[i];
+        exhaust_accum[i] -= (f32)n;
+
+        // Behind the drawn hull, which render_ship keeps at least 8 px long
+        f32 size = MAX(ship->radius * 3.0f, 8.0f / cam->ppm);
+        f32 dx = cosf(ship->angle), dy = sinf(ship->angle);
+        f32 ex = ship->pos.x - dx * size * 0.5f;
+        f32 ey = ship->pos.y - dy * size * 0.5f;
+
+        for (s32 k = 0; k < n; k++) {
+            // Spread spawns over the frame's path so they do not clump
+            f32 back = frand() * dt;
+            f32 side = frange(-0.6f, 0.6f);
+            f32 speed = EXHAUST_SPEED * frange(0.6f, 1.0f);
+            spawn(ex - ship->vel.x * back, ey - ship->vel.y * back,
+                  ship->vel.x - dx * speed - dy * side,
+                  ship->vel.y - dy * speed + dx * side,
+                  frange(0.25f, 0.5f), frange(1.5f, 2.5f), RAMP_EXHAUST);
+        }
+    }
+}
+
+// Advance every particle, four at a time
+static void integrate(f32 dt) {
+    f32x4 vdt   = f32x4_set1(dt);
+    f32x4 vdamp = f32x4_set1(expf(-DRAG * dt));
+    s32 n = (pool.count + F32X4_WIDTH - 1) & ~(F32X4_WIDTH - 1);
+
+    for (s32 i = 0; i < n; i += F32X4_WIDTH) {
+        f32x4 vx = f32x4_mul(f32x4_load(&pool.vx[i]), vdamp);
+        f32x4 vy = f32x4_mul(f32x4_load(&pool.vy[i]), vdamp);
+        f32x4 x  = f32x4_add(f32x4_load(&pool.x[i]), f32x4_mul(vx, vdt));
+        f32x4 y  = f32x4_add(f32x4_load(&pool.y[i]), f32x4_mul(vy, vdt));
+        f32x4 age = f32x4_add(f32x4_load(&pool.age[i]),
+                              f32x4_mul(f32x4_load(&pool.rate[i]), vdt));
+        f32x4_store(&pool.vx[i], vx);
+        f32x4_store(&pool.vy[i], vy);
+        f32x4_store(&pool.x[i], x);
+        f32x4_store(&pool.y[i], y);
+        f32x4_store(&pool.age[i], age);
+    }
+}
+
+// Swap-remove the dead: the last live particle moves into each freed slot
+static void recycle(void) {
+    for (s32 i = 0; i < pool.count; ) {
+        if (pool.age[i] < 1.0f) {
+            i++;
+            continue;
+        }
+        s32 last = --pool.count;
+        pool.x[i]    = pool.x[last];
+        pool.y[i]    = pool.y[last];
+        pool.vx[i]   = pool.vx[last];
+        pool.vy[i]   = pool.vy[last];
+        pool.age[i]  = pool.age[last];
+        pool.rate[i] = pool.rate[last];
+        pool.size[i] = pool.size[last];
+        pool.ramp[i] = pool.ramp[last];
+    }
+}
+
+void particles_update(const Game *game, f32 dt) {
+    spawn_events(game);
+    spawn_exhaust(game, dt);
+    integrate(dt);
+    recycle();
+}
+
+static SDL_FColor ramp_color(const Ramp *r, f32 t) {
+    return (SDL_FColor){
+        r->from.r + (r->to.r - r->from.r) * t,
+        r->from.g + (r->to.g - r->from.g) * t,
+        r->from.b + (r->to.b - r->from.b) * t,
+        r->from.a + (r->to.a - r->from.a) * t,
+    };
+}
+
+void render_particles(SDL_Renderer *renderer, const Game *game) {
+    (void)renderer;
+    const Camera *cam = &game->cam;
+
+    s32 nv = 0;
+    for (s32 i = 0; i < pool.count; i++) {
+        f32 sx = world_to_screen_x(cam, pool.x[i]);
+        f32 sy = world_to_screen_y(cam, pool.y[i]);
+        f32 s  = pool.size[i];
+        if (!screen_circle_visible(cam, sx, sy, s)) continue;
+
+        SDL_FColor c = ramp_color(&ramps[pool.ramp[i]], pool.age[i]);
+        // Triangle inscribed in a circle of radius s
+        vert_xy[nv + 0] = (SDL_FPoint){ sx, sy - s };
+        vert_xy[nv + 1] = (SDL_FPoint){ sx + s * 0.866f, sy + s * 0.5f };
+        vert_xy[nv + 2] = (SDL_FPoint){ sx - s * 0.866f, sy + s * 0.5f };
+        vert_color[nv + 0] = c;
+        vert_color[nv + 1] = c;
+        vert_color[nv + 2] = c;
+        nv += 3;
+    }
+
+    if (nv > 0)
+        batch_submit_triangles(SDL_BLENDMODE_ADD, vert_xy, vert_color, nv);
+}
+
+void particles_clear(void) {
+    pool.count = 0;
+    SDL_memset(exhaust_accum, 0, sizeof(exhaust_accum));
+}
+
+s32 particles_count(void) {
+    return pool.count;
+}
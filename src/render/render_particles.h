@@ -0,0 +1,22 @@
+#pragma once
+
+#include <SDL3/SDL.h>
+#include "game/game.h"
+
+// Particle effects: engine exhaust while ships fly, bursts when physics
+// reports a crash or an arrival (PhysState.events).
+//
+// Particles live in a fixed structure-of-arrays pool in world space; dead
+// ones are recycled by swapping the last live particle into their slot, so
+// the live range stays dense and nothing is allocated after startup. The
+// integrator runs four particles per instruction through q_simd.h, and the
+// whole pool is drawn as one additive triangle list (one draw call).
+
+#define PARTICLE_CAPACITY 32768
+
+// Spawn from this frame's physics events and thrust, then advance by `dt`
+void particles_update(const Game *game, f32 dt);
+void render_particles(SDL_Renderer *renderer, const Game *game);
+// Drop every particle (level load)
+void particles_clear(void);
+s32  particles_count(void);
@@ -3,4 +3,7 @@
 #include <SDL3/SDL.h>
 #include "game/game.h"
 
+// Rotating planet bodies (drawn every frame)
 void render_planets(SDL_Renderer *renderer, const Game *game);
+// Atmosphere glow and goal rings; camera-static, drawn into the static layer
+void render_planet_rings(const Game *game);
@@ -0,0 +1,209 @@
+#include "render/render_scale.h"
+#include <math.h>
+
+#define SMOOTH          0.1f    // EMA factor for the frame times
+#define SPIKE_CLAMP     2.0f    // inputs are clamped to this many budgets
+#define OVER_BUDGET     1.10f   // smoothed interval above budget * this drops the scale
+#define HEADROOM        0.70f   // busy time below budget * this allows probing up
+#define SETTLE_FRAMES   30      // frames for the EMAs to catch up after a change
+#define PROBE_FRAMES    120     // frames of headroom before stepping up
+#define PROBE_MAX       1920    // back-off cap after repeated failed probes
+
+static SDL_Texture *target;
+static s32  target_w, target_h;
+static bool target_failed;      // no render-target support: draw directly
+static bool drawing;            // target bound between begin and end
+
+static f32  scale    = RENDER_SCALE_MAX;
+static f32  density  = 1.0f;
+static f32  ratio    = 1.0f;
+static s32  view_w, view_h;     // pixels drawn this frame
+static bool adaptive = true;
+static f32  budget   = 1000.0f / RENDER_SCALE_REFRESH_HZ;
+
+// Controller
+static f32  frame_ms, busy_ms, present_ms;
+static s32  settle;             // frames left before the next decision
+static s32  headroom;           // consecutive frames with time to spare
+static s32  probe_wait = PROBE_FRAMES;
+static bool probing;            // last change was a step up, not yet confirmed
+
+static f32 snap_scale(f32 s) {
+    s = floorf(s / RENDER_SCALE_STEP + 0.5f) * RENDER_SCALE_STEP;
+    return CLAMP(s, RENDER_SCALE_MIN, RENDER_SCALE_MAX);
+}
+
+static void change_scale(f32 s) {
+    scale    = snap_scale(s);
+    settle   = SETTLE_FRAMES;
+    headroom = 0;
+}
+
+// One refresh of the display the window is on; the window may have moved
+static void update_budget(SDL_Window *window) {
+    f32 hz = RENDER_SCALE_REFRESH_HZ;
+    const SDL_DisplayMode *mode = SDL_GetCurrentDisplayMode(SDL_GetDisplayForWindow(window));
+    if (mode && mode->refresh_rate > 0.0f)
+        hz = mode->refresh_rate;
+    budget = 1000.0f / hz;
+}
+
+static bool ensure_target(SDL_Renderer *renderer, s32 w, s32 h) {
+    if (target && target_w == w && target_h == h)
+        return true;
+
+    if (target) SDL_DestroyTexture(target);
+    target = SDL_CreateTexture(renderer, SDL_PIXELFORMAT_RGBA8888,
+                               SDL_TEXTUREACCESS_TARGET, w, h);
+    if (!target) {
+        SDL_Log("render_scale: failed to create %dx%d target: %s", w, h, SDL_GetError());
+        target_failed = true;
+        target_w = target_h = 0;
+        return false;
+    }
+    // Opaque: every frame clears it, so compositing needs no blending
+    SDL_SetTextureBlendMode(target, SDL_BLENDMODE_NONE);
+    SDL_SetTextureScaleMode(target, SDL_SCALEMODE_LINEAR);
+    target_w = w;
+    target_h = h;
+    return true;
+}
+
+void render_scale_begin(SDL_Renderer *renderer, SDL_Window *window, Camera *cam) {
+    int pts_w = 0, pts_h = 0, px_w = 0, px_h = 0;
+    SDL_GetWindowSize(window, &pts_w, &pts_h);
+    SDL_GetRenderOutputSize(renderer, &px_w, &px_h);
+    if (pts_w <= 0 || pts_h <= 0 || px_w <= 0 || px_h <= 0)
+        return;   // minimized
+
+    cam->screen_w = pts_w;
+    cam->screen_h = pts_h;
+    density = (f32)px_w / (f32)pts_w;
+    update_budget(window);
+
+    s64 max_size = SDL_GetNumberProperty(SDL_GetRendererProperties(renderer),
+                                         SDL_PROP_RENDERER_MAX_TEXTURE_SIZE_NUMBER, 8192);
+    s32 w = CLAMP((s32)(px_w * scale + 0.5f), 1, (s32)max_size);
+    s32 h = CLAMP((s32)(px_h * scale + 0.5f), 1, (s32)max_size);
+
+    drawing = !target_failed && ensure_target(renderer, w, h);
+    if (!drawing) {
+        w = px_w;
+        h = px_h;
+    }
+    view_w = w;
+    view_h = h;
+    if (drawing) {
+        SDL_SetRenderTarget(renderer, target);
+        ratio = (f32)w / (f32)pts_w;
+        SDL_SetRenderScale(renderer, ratio, (f32)h / (f32)pts_h);
+    } else {
+        ratio = density;
+        SDL_SetRenderScale(renderer, density, (f32)h / (f32)pts_h);
+    }
+}
+
+void render_scale_end(SDL_Renderer *renderer) {
+    SDL_SetRenderScale(renderer, 1.0f, 1.0f);
+    if (!drawing) return;
+    drawing = false;
+
+    SDL_SetRenderTarget(renderer, NULL);
+    SDL_RenderTexture(renderer, target, NULL, NULL);
+}
+
+void render_scale_update(f32 frame, f32 busy, f32 present) {
+    // One hitch (level load, GC pause) must not read as a slow GPU
+    frame   = MIN(frame, budget * SPIKE_CLAMP);
+    busy    = MIN(busy, budget * SPIKE_CLAMP);
+    present = MIN(present, budget * SPIKE_CLAMP);
+    if (frame_ms <= 0.0f) {
+        frame_ms   = frame;
+        busy_ms    = busy;
+        present_ms = present;
+    } else {
+        frame_ms   += (frame - frame_ms) * SMOOTH;
+        busy_ms    += (busy - busy_ms) * SMOOTH;
+        present_ms += (present - present_ms) * SMOOTH;
+    }
+
+    if (!adaptive) return;
+    if (settle > 0) {
+        settle--;
+        return;
+    }
+
+    // A long interval the frame itself does not account for is a wait for
+    // the next vsync (30/50 Hz display, throttled rAF), not a slow GPU: a
+    // GPU that cannot keep up shows as present blocking on it
+    bool over = frame_ms > budget * OVER_BUDGET &&
+                busy_ms + present_ms > budget * OVER_BUDGET;
+    if (over) {
+        // The last step up did not hold: wait longer before the next one
+        if (probing) probe_wait = MIN(probe_wait * 2, PROBE_MAX);
+        probing = false;
+        if (scale > RENDER_SCALE_MIN) {
+            // Fill cost goes with area; aim straight for the budget
+            f32 want = scale * sqrtf(budget / frame_ms);
+            change_scale(MIN(want, scale - RENDER_SCALE_STEP));
+        }
+        return;
+    }
+
+    if (probing) {
+        probing    = false;
+        probe_wait = PROBE_FRAMES;
+    }
+
+    if (scale < RENDER_SCALE_MAX && busy_ms < budget * HEADROOM) {
+        if (++headroom >= probe_wait) {
+            change_scale(scale + RENDER_SCALE_STEP);
+            probing = true;
+        }
+    } else {
+        headroom = 0;
+    }
+}
+
+void render_scale_set_adaptive(bool on) {
+    adaptive   = on;
+    settle     = 0;
+    headroom   = 0;
+    probing    = false;
+    probe_wait = PROBE_FRAMES;
+}
+
+void render_scale_set(f32 s) {
+    render_scale_set_adaptive(false);
+    scale = snap_scale(s);
+}
+
+RenderScaleStats render_scale_stats(void) {
+    return (RenderScaleStats){
+        .scale      = scale,
+        .density    = density,
+        .width      = view_w,
+        .height     = view_h,
+        .frame_ms   = frame_ms,
+        .busy_ms    = busy_ms,
+        .present_ms = present_ms,
+        .budget_ms  = budget,
+        .adaptive   = adaptive,
+    };
+}
+
+f32 render_scale_pixel_ratio(void) {
+    return ratio;
+}
+
+f32 render_scale_density(void) {
+    return density;
+}
+
+void render_scale_shutdown(void) {
+    if (target) SDL_DestroyTexture(target);
+    target = NULL;
+    target_w = target_h = 0;
+    target_failed = false;
+    drawing = false;
+}
@@ -0,0 +1,60 @@
+#pragma once
+
+#include <SDL3/SDL.h>
+#include "utils/q_util.h"
+#include "game/game.h"
+
+// Dynamic resolution. The world is drawn into an offscreen target whose
+// size is the window's pixel size (HiDPI included) times a scale factor,
+// and render_scale_end() stretches it over the window before the UI is
+// drawn at full resolution. A controller fed with frame times lowers the
+// scale as soon as frames run over budget and probes back up while there
+// is headroom, backing off further each time a probe fails. The frame
+// budget is one refresh of the display the window is on.
+//
+// Drawing code keeps working in window points: the camera is sized in
+// points and the target's render scale maps them to its pixels, so mouse
+// coordinates, line widths and HUD offsets do not depend on the scale.
+
+#define RENDER_SCALE_MIN       0.5f
+#define RENDER_SCALE_MAX       1.0f
+#define RENDER_SCALE_STEP      (1.0f / 16.0f)    // scales are multiples of this
+#define RENDER_SCALE_REFRESH_HZ 60.0f   // when the display does not report a rate
+
+typedef struct {
+    f32  scale;        // internal / native resolution
+    f32  density;      // window pixels per point
+    s32  width;        // internal target, pixels
+    s32  height;
+    f32  frame_ms;     // smoothed frame interval the controller sees
+    f32  busy_ms;      // smoothed CPU time spent on the frame
+    f32  present_ms;   // smoothed time spent in present
+    f32  budget_ms;    // one refresh of the window's display
+    bool adaptive;     // false = scale is held where it was set
+} RenderScaleStats;
+
+// Size `cam` to the window and redirect drawing into the internal target.
+// Falls back to drawing straight into the window (at the pixel density)
+// when render targets are unavailable.
+void render_scale_begin(SDL_Renderer *renderer, SDL_Window *window, Camera *cam);
+// Back to the window; upscale the internal target over it
+void render_scale_end(SDL_Renderer *renderer);
+// Feed the wall time since the previous frame, the part of it the frame
+// spent working outside present and the time present took; adjusts the
+// scale. An interval over budget only lowers the scale when the work plus
+// present fills it too: otherwise the frame was waiting for a vsync (or a
+// throttled requestAnimationFrame), and fewer pixels would not help.
+void render_scale_update(f32 frame_ms, f32 busy_ms, f32 present_ms);
+
+void render_scale_set_adaptive(bool adaptive);
+// Fix the scale (snapped to RENDER_SCALE_STEP); disables adaptation
+void render_scale_set(f32 scale);
+RenderScaleStats render_scale_stats(void);
+
+// Internal target pixels per point, for layers that cache screen-sized
+// images, and the window's own density, for sizing detail independent of
+// the current scale
+f32  render_scale_pixel_ratio(void);
+f32  render_scale_density(void);
+
+void render_scale_shutdown(void);
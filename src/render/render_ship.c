@@ -1,21 +1,8 @@
 #include "render/render_ship.h"
+#include "render/render.h"
 #include <math.h>
 
-// Draw a filled triangle using SDL_RenderGeometry (1 draw call)
-static void fill_triangle(SDL_Renderer *renderer,
-                           f32 x0, f32 y0,
-                           f32 x1, f32 y1,
-                           f32 x2, f32 y2,
-                           SDL_FColor color) {
-    SDL_Vertex verts[3] = {
-        { .position = { x0, y0 }, .color = color, .tex_coord = { 0, 0 } },
-        { .position = { x1, y1 }, .color = color, .tex_coord = { 0, 0 } },
-        { .position = { x2, y2 }, .color = color, .tex_coord = { 0, 0 } },
-    };
-    SDL_RenderGeometry(renderer, NULL, verts, 3, NULL, 0);
-}
-
-static void draw_aim_line(SDL_Renderer *renderer, const Game *game) {
+static void draw_aim_line(const Game *game) {
     const Camera *cam = &game->cam;
     const Ship *ship = &game->ships[0];
     const AimState *aim = &game->aim;
@@ -62,8 +49,8 @@ static void draw_aim_line(SDL_Renderer *renderer, const Game *game) {
     }
 
     // Main aim line
-    SDL_SetRenderDrawColor(renderer, r, g, 50, 255);
-    SDL_RenderLine(renderer, ship_sx, ship_sy, end_sx, end_sy);
+    SDL_FColor color = color_u8(r, g, 50, 255);
+    batch_line(ship_sx, ship_sy, end_sx, end_sy, 1.0f, color);
 
     // Arrowhead at the end
     f32 dx = end_sx - ship_sx;
@@ -78,14 +65,14 @@ static void draw_aim_line(SDL_Renderer *renderer, const Game *game) {
         f32 ay1 = end_sy - uy * arrow - ux * arrow * 0.5f;
         f32 ax2 = end_sx - ux * arrow - uy * arrow * 0.5f;
         f32 ay2 = end_sy - uy * arrow + ux * arrow * 0.5f;
-        SDL_RenderLine(renderer, end_sx, end_sy, ax1, ay1);
-        SDL_RenderLine(renderer, end_sx, end_sy, ax2, ay2);
+        batch_line(end_sx, end_sy, ax1, ay1, 1.0f, color);
+        batch_line(end_sx, end_sy, ax2, ay2, 1.0f, color);
     }
 }
 
-static void draw_one_ship(SDL_Renderer *renderer, const Camera *cam,
-                           const Ship *ship, bool is_leader, bool is_arrived,
-                           bool is_playing) {
+// Engine exhaust comes from the particle system (render_particles.c)
+static void draw_one_ship(const Camera *cam, const Ship *ship,
+                           bool is_leader, bool is_arrived) {
     f32 sx = world_to_screen_x(cam, ship->pos.x);
     f32 sy = world_to_screen_y(cam, ship->pos.y);
     f32 sr = world_to_screen_r(cam, ship->radius);
@@ -93,6 +80,7 @@ static void draw_one_ship(SDL_Renderer *renderer, const Camera *cam,
     // Ship is a triangle pointing in the direction of ship->angle
     f32 size = sr * 3.0f;
     if (size < 8.0f) size = 8.0f;
+    if (!batch_visible_circle(cam, sx, sy, size + 1.0f)) return;
 
     f32 a = ship->angle;
 
@@ -108,20 +96,6 @@ static void draw_one_ship(SDL_Renderer *renderer, const Camera *cam,
     f32 rx = sx + cosf(a - 2.4f) * size * 0.7f;
     f32 ry = sy - sinf(a - 2.4f) * size * 0.7f;
 
-    // Engine glow (only when playing and not arrived)
-    if (is_playing && !is_arrived) {
-        f32 ex = sx - cosf(a) * size * 0.5f;
-        f32 ey = sy + sinf(a) * size * 0.5f;
-
-        f32 el = sx + cosf(a + 2.8f) * size * 0.3f;
-        f32 ely = sy - sinf(a + 2.8f) * size * 0.3f;
-        f32 er = sx + cosf(a - 2.8f) * size * 0.3f;
-        f32 ery = sy - sinf(a - 2.8f) * size * 0.3f;
-
-        SDL_FColor glow_color = { 1.0f, 160.0f/255.0f, 40.0f/255.0f, 140.0f/255.0f };
-        fill_triangle(renderer, ex, ey, el, ely, er, ery, glow_color);
-    }
-
     // Ship body color
     SDL_FColor body_color;
     if (is_arrived) {
@@ -131,35 +105,31 @@ static void draw_one_ship(SDL_Renderer *renderer, const Camera *cam,
     } else {
         body_color = (SDL_FColor){ 160.0f/255.0f, 240.0f/255.0f, 230.0f/255.0f, 1.0f };
     }
-    fill_triangle(renderer, nx, ny, lx, ly, rx, ry, body_color);
+    batch_triangle(nx, ny, lx, ly, rx, ry, body_color);
 
-    // Ship outline using SDL_RenderLines (1 call instead of 3)
+    // Ship outline
+    SDL_FColor outline;
     if (is_arrived) {
-        SDL_SetRenderDrawBlendMode(renderer, SDL_BLENDMODE_BLEND);
-        SDL_SetRenderDrawColor(renderer, 60, 200, 100, 120);
+        outline = color_u8(60, 200, 100, 120);
     } else if (is_leader) {
-        SDL_SetRenderDrawColor(renderer, 140, 180, 255, 255);
+        outline = color_u8(140, 180, 255, 255);
     } else {
-        SDL_SetRenderDrawColor(renderer, 100, 200, 200, 255);
-    }
-    SDL_FPoint outline[4] = {
-        { nx, ny }, { lx, ly }, { rx, ry }, { nx, ny }
-    };
-    SDL_RenderLines(renderer, outline, 4);
-
-    if (is_arrived) {
-        SDL_SetRenderDrawBlendMode(renderer, SDL_BLENDMODE_NONE);
+        outline = color_u8(100, 200, 200, 255);
     }
+    batch_line(nx, ny, lx, ly, 1.0f, outline);
+    batch_line(lx, ly, rx, ry, 1.0f, outline);
+    batch_line(rx, ry, nx, ny, 1.0f, outline);
 }
 
 void render_ship(SDL_Renderer *renderer, const Game *game) {
+    (void)renderer;
     const Camera *cam = &game->cam;
-    bool is_playing = (game->state == GAME_STATE_PLAYING);
+
+    batch_set_blend(SDL_BLENDMODE_BLEND);
 
     // Draw tether lines from leader to alive followers
     if (game->fleet_count > 1 && game->ships[0].alive && !game->ships[0].arrived) {
-        SDL_SetRenderDrawBlendMode(renderer, SDL_BLENDMODE_BLEND);
-        SDL_SetRenderDrawColor(renderer, 200, 200, 200, 80);
+        SDL_FColor tether = color_u8(200, 200, 200, 80);
 
         f32 leader_sx = world_to_screen_x(cam, game->ships[0].pos.x);
         f32 leader_sy = world_to_screen_y(cam, game->ships[0].pos.y);
@@ -169,10 +139,9 @@ void render_ship(SDL_Renderer *renderer, const Game *game) {
 
             f32 fsx = world_to_screen_x(cam, game->ships[i].pos.x);
             f32 fsy = world_to_screen_y(cam, game->ships[i].pos.y);
-            SDL_RenderLine(renderer, leader_sx, leader_sy, fsx, fsy);
+            if (!batch_visible_segment(cam, leader_sx, leader_sy, fsx, fsy, 1.0f)) continue;
+            batch_line(leader_sx, leader_sy, fsx, fsy, 1.0f, tether);
         }
-
-        SDL_SetRenderDrawBlendMode(renderer, SDL_BLENDMODE_NONE);
     }
 
     // Draw each ship
@@ -180,11 +149,11 @@ void render_ship(SDL_Renderer *renderer, const Game *game) {
         const Ship *ship = &game->ships[i];
         if (!ship->alive && !ship->arrived) continue;
 
-        draw_one_ship(renderer, cam, ship, i == 0, ship->arrived, is_playing);
+        draw_one_ship(cam, ship, i == 0, ship->arrived);
     }
 
     // Aim line (while dragging) — from leader only
     if (game->aim.aiming) {
-        draw_aim_line(renderer, game);
+        draw_aim_line(game);
     }
 }
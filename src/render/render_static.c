@@ -0,0 +1,114 @@
+#include "render/render_static.h"
+#include "render/render.h"
+#include "utils/profiler.h"
+
+static SDL_Texture *layer;
+static s32 layer_w, layer_h;
+static u64 layer_key;
+static bool layer_valid;
+
+// FNV-1a over the inputs the cached geometry depends on
+static u64 layer_hash(const Game *game, f32 ratio) {
+    const Camera *cam = &game->cam;
+    u64 h = FNV1A64_SEED;
+    h = fnv1a64_f32(h, ratio);
+    h = fnv1a64_f32(h, cam->ppm);
+    h = fnv1a64_f32(h, cam->cam_x);
+    h = fnv1a64_f32(h, cam->cam_y);
+    h = fnv1a64_f32(h, (f32)cam->screen_w);
+    h = fnv1a64_f32(h, (f32)cam->screen_h);
+
+    h = fnv1a64_f32(h, game->bounds_min.x);
+    h = fnv1a64_f32(h, game->bounds_min.y);
+    h = fnv1a64_f32(h, game->bounds_max.x);
+    h = fnv1a64_f32(h, game->bounds_max.y);
+    h = fnv1a64_f32(h, game->goal.pos.x);
+    h = fnv1a64_f32(h, game->goal.pos.y);
+    h = fnv1a64_f32(h, game->goal.radius);
+
+    h = fnv1a64_f32(h, (f32)game->planet_count);
+    for (s32 i = 0; i < game->planet_count; i++) {
+        const Planet *p = &game->planets[i];
+        h = fnv1a64_f32(h, p->pos.x);
+        h = fnv1a64_f32(h, p->pos.y);
+        h = fnv1a64_f32(h, p->radius);
+        h = fnv1a64_f32(h, (f32)p->type);
+    }
+    return h;
+}
+
+static void draw_static_geometry(SDL_Renderer *renderer, const Game *game) {
+    render_bounds(renderer, game);
+    render_planet_rings(game);
+}
+
+static bool ensure_layer(SDL_Renderer *renderer, s32 w, s32 h) {
+    if (layer && layer_w == w && layer_h == h)
+        return true;
+
+    if (layer) SDL_DestroyTexture(layer);
+    layer = SDL_CreateTexture(renderer, SDL_PIXELFORMAT_RGBA8888,
+                              SDL_TEXTUREACCESS_TARGET, w, h);
+    layer_valid = false;
+    if (!layer) {
+        SDL_Log("static_layer: failed to create %dx%d target: %s", w, h, SDL_GetError());
+        return false;
+    }
+    SDL_SetTextureScaleMode(layer, SDL_SCALEMODE_NEAREST);
+    layer_w = w;
+    layer_h = h;
+    return true;
+}
+
+void render_static_layer(SDL_Renderer *renderer, const Game *game) {
+    const Camera *cam = &game->cam;
+
+    // The layer matches the pixels of the target it is composited into
+    f32 ratio = render_scale_pixel_ratio();
+    s32 w = MAX(1, (s32)(cam->screen_w * ratio + 0.5f));
+    s32 h = MAX(1, (s32)(cam->screen_h * ratio + 0.5f));
+    if (!ensure_layer(renderer, w, h)) {
+        // No render-target support: draw live
+        draw_static_geometry(renderer, game);
+        return;
+    }
+
+    u64 key = layer_hash(game, ratio);
+    if (!layer_valid || key != layer_key) {
+        PROF_BEGIN("static_layer_rebuild");
+        batch_flush();
+        SDL_Texture *prev_target = SDL_GetRenderTarget(renderer);
+        SDL_SetRenderTarget(renderer, layer);
+        SDL_SetRenderScale(renderer, (f32)layer_w / cam->screen_w, (f32)layer_h / cam->screen_h);
+        SDL_SetRenderDrawColor(renderer, 0, 0, 0, 0);
+        SDL_RenderClear(renderer);
+
+        // Alpha-blending onto transparent black leaves premultiplied color
+        // in the target, so the layer composites with BLEND_PREMULTIPLIED.
+        draw_static_geometry(renderer, game);
+        batch_flush();
+
+        SDL_SetRenderTarget(renderer, prev_target);
+        layer_key = key;
+        layer_valid = true;
+        PROF_END();
+    }
+
+    batch_set_blend(SDL_BLENDMODE_BLEND_PREMULTIPLIED);
+    f32 half_w = cam->screen_w * 0.5f;
+    f32 half_h = cam->screen_h * 0.5f;
+    batch_sprite(layer, NULL, half_w, half_h, half_w, half_h, 0.0f,
+                 (SDL_FColor){ 1.0f, 1.0f, 1.0f, 1.0f });
+    batch_set_blend(SDL_BLENDMODE_BLEND);
+}
+
+void static_layer_invalidate(void) {
+    layer_valid = false;
+}
+
+void static_layer_shutdown(void) {
+    if (layer) SDL_DestroyTexture(layer);
+    layer = NULL;
+    layer_w = layer_h = 0;
+    layer_valid = false;
+}
@@ -0,0 +1,13 @@
+#pragma once
+
+#include <SDL3/SDL.h>
+#include "game/game.h"
+
+// Camera-static world geometry (bounds, planet glow rings, goal rings)
+// cached in a render-target texture. The layer is re-rendered only when the
+// camera, screen size or level geometry changes; otherwise it costs one
+// textured quad per frame.
+void render_static_layer(SDL_Renderer *renderer, const Game *game);
+// Force a re-render on the next frame (e.g. after a device reset)
+void static_layer_invalidate(void);
+void static_layer_shutdown(void);
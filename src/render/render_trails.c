@@ -0,0 +1,90 @@
+#include "render/render_trails.h"
+#include "render/render.h"
+#include <math.h>
+
+#define TRAIL_WIDTH 3.0f     // pixels at the ship; tapers to 0 at the tail
+#define TRAIL_ALPHA 0.6f     // at the ship; fades to 0 at the tail
+
+// Screen-space points of the trails that passed culling
+static SDL_FPoint screen[MAX_FLEET][TRAIL_CAPACITY + 1];
+
+static SDL_FColor trail_color(s32 ship) {
+    // Matches the ship outlines in render_ship.c
+    return ship == 0 ? color_u8(140, 180, 255, 255) : color_u8(100, 200, 200, 255);
+}
+
+// Two vertices per point across the local direction, half-width `half`
+static void emit_point(SDL_Vertex *v, const SDL_FPoint *pts, s32 n, s32 k,
+                       f32 half, SDL_FColor color) {
+    SDL_FPoint a = pts[k > 0 ? k - 1 : k];
+    SDL_FPoint b = pts[k < n - 1 ? k + 1 : k];
+    f32 dx = b.x - a.x;
+    f32 dy = b.y - a.y;
+    f32 len = sqrtf(dx * dx + dy * dy);
+    f32 nx = 0.0f, ny = 0.0f;
+    if (len > 1e-3f) {
+        nx = -dy / len * half;
+        ny =  dx / len * half;
+    }
+    v[0] = (SDL_Vertex){ { pts[k].x + nx, pts[k].y + ny }, color, { 0, 0 } };
+    v[1] = (SDL_Vertex){ { pts[k].x - nx, pts[k].y - ny }, color, { 0, 0 } };
+}
+
+void render_trails(SDL_Renderer *renderer, const Game *game) {
+    (void)renderer;
+    const Camera *cam = &game->cam;
+
+    // Project and cull first so the batch space is reserved once
+    s32 lens[MAX_FLEET] = {0};
+    s32 num_verts = 0, num_indices = 0;
+    for (s32 i = 0; i < game->fleet_count; i++) {
+        const Trail *t = &game->trails[i];
+        s32 n = trail_length(t);
+        if (n < 2) continue;
+
+        f32 min_x = INFINITY, min_y = INFINITY, max_x = -INFINITY, max_y = -INFINITY;
+        for (s32 k = 0; k < n; k++) {
+            TrailPoint p = trail_point(t, k);
+            SDL_FPoint s = { world_to_screen_x(cam, p.x), world_to_screen_y(cam, p.y) };
+            screen[i][k] = s;
+            min_x = MIN(min_x, s.x);
+            min_y = MIN(min_y, s.y);
+            max_x = MAX(max_x, s.x);
+            max_y = MAX(max_y, s.y);
+        }
+        if (!batch_visible_segment(cam, min_x, min_y, max_x, max_y, TRAIL_WIDTH))
+            continue;
+
+        lens[i] = n;
+        num_verts   += n * 2;
+        num_indices += (n - 1) * 6;
+    }
+    if (num_verts == 0) return;
+
+    batch_set_blend(SDL_BLENDMODE_BLEND);
+    int *idx, base;
+    SDL_Vertex *v = batch_reserve(NULL, num_verts, num_indices, &idx, &base);
+    if (!v) return;
+
+    for (s32 i = 0; i < game->fleet_count; i++) {
+        s32 n = lens[i];
+        if (n == 0) continue;
+
+        SDL_FColor color = trail_color(i);
+        for (s32 k = 0; k < n; k++) {
+            // 0 at the oldest point, 1 at the ship
+            f32 f = (f32)k / (f32)(n - 1);
+            SDL_FColor c = color;
+            c.a = TRAIL_ALPHA * f;
+            emit_point(v, screen[i], n, k, TRAIL_WIDTH * 0.5f * f, c);
+            v += 2;
+        }
+        for (s32 k = 0; k < n - 1; k++) {
+            int b = base + k * 2;
+            idx[0] = b;     idx[1] = b + 1; idx[2] = b + 2;
+            idx[3] = b + 1; idx[4] = b + 3; idx[5] = b + 2;
+            idx += 6;
+        }
+        base += n * 2;
+    }
+}
@@ -0,0 +1,9 @@
+#pragma once
+
+#include <SDL3/SDL.h>
+#include "game/game.h"
+
+// Ship motion trails (game/trail.h) as width- and alpha-tapered ribbons.
+// Every visible trail goes into a single batch reservation, so the whole
+// fleet costs one draw call however many ships it has.
+void render_trails(SDL_Renderer *renderer, const Game *game);
@@ -0,0 +1,198 @@
+// Level compiler: JSON levels (the authoring format) to .gbl and .gbp.
+//
+//   GravityLevelCompile level.json [more.json ...]      -> level.gbl next to each
+//   GravityLevelCompile -o out.gbl level.json
+//   GravityLevelCompile -p levels.gbp a.json b.json ... -> one pack, in order
+//
+// Exit code is 0 when every level compiles, 1 otherwise.
+
+#include <SDL3/SDL.h>
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "data/json.h"
+#include "data/level_bin.h"
+#include "data/level_pack.h"
+
+// Thumbnail colours: one flat tone per planet type
+static const u8 planet_rgb[PLANET_TYPE_COUNT][3] = {
+    [PLANET_TYPE_ROCKY]       = { 140, 120, 100 },
+    [PLANET_TYPE_TERRESTRIAL] = {  50, 120, 110 },
+    [PLANET_TYPE_GAS_GIANT]   = { 200, 160,  90 },
+    [PLANET_TYPE_ICE]         = { 180, 205, 235 },
+    [PLANET_TYPE_VOLCANIC]    = { 200,  80,  30 },
+};
+
+// "dir/name.json" -> stem "name" (start, length)
+static const char *path_stem(const char *path, int *len) {
+    const char *stem = path;
+    for (const char *c = path; *c; c++)
+        if (*c == '/' || *c == '\\') stem = c + 1;
+    const char *dot = strrchr(stem, '.');
+    *len = dot ? (int)(dot - stem) : (int)strlen(stem);
+    return stem;
+}
+
+// "dir/name.json" -> "dir/name.gbl"
+static void output_path(char *out, size_t cap, const char *in) {
+    int stem_len;
+    const char *stem = path_stem(in, &stem_len);
+    snprintf(out, cap, "%.*s.gbl", (int)(stem - in) + stem_len, in);
+}
+
+static void fill_disc(u8 *rgba, f32 cx, f32 cy, f32 r, const u8 rgb[3]) {
+    r = MAX(r, 0.75f);   // keep small bodies visible
+    for (s32 y = 0; y < LEVEL_THUMB_H; y++) {
+        for (s32 x = 0; x < LEVEL_THUMB_W; x++) {
+            f32 dx = (f32)x + 0.5f - cx, dy = (f32)y + 0.5f - cy;
+            if (dx * dx + dy * dy > r * r) continue;
+            u8 *px = &rgba[(y * LEVEL_THUMB_W + x) * 4];
+            px[0] = rgb[0];
+            px[1] = rgb[1];
+            px[2] = rgb[2];
+        }
+    }
+}
+
+// Top-down sketch of the level bounds: planets, start (white), goal (green)
+static void render_thumb(const LevelDesc *desc, u8 *rgba) {
+    static const u8 space[3] = { 8, 10, 20 };
+    static const u8 start[3] = { 240, 240, 240 };
+    static const u8 goal[3]  = { 60, 220, 90 };
+
+    for (s32 i = 0; i < LEVEL_THUMB_W * LEVEL_THUMB_H; i++) {
+        rgba[i * 4 + 0] = space[0];
+        rgba[i * 4 + 1] = space[1];
+        rgba[i * 4 + 2] = space[2];
+        rgba[i * 4 + 3] = 255;
+    }
+
+    // Fit the bounds, preserving aspect, centred
+    f32 w = desc->bounds_max.x - desc->bounds_min.x;
+    f32 h = desc->bounds_max.y - desc->bounds_min.y;
+    if (w <= 0.0f || h <= 0.0f) return;
+    f32 s  = MIN(LEVEL_THUMB_W / w, LEVEL_THUMB_H / h);
+    f32 ox = (LEVEL_THUMB_W - w * s) * 0.5f;
+    f32 oy = (LEVEL_THUMB_H - h * s) * 0.5f;
+    // World y is up, thumbnail rows go down
+#define TX(wx) (ox + ((wx) - desc->bounds_min.x) * s)
+#define TY(wy) (oy + (desc->bounds_max.y - (wy)) * s)
+
+    for (s32 i = 0; i < desc->planet_count; i++) {
+        const LevelPlanet *p = &desc->planets[i];
+        fill_disc(rgba, TX(p->pos.x), TY(p->pos.y), p->radius * s,
+                  planet_rgb[p->type % PLANET_TYPE_COUNT]);
+    }
+    fill_disc(rgba, TX(desc->goal_pos.x), TY(desc->goal_pos.y), desc->goal_radius * s, goal);
+    fill_disc(rgba, TX(desc->start_pos.x), TY(desc->start_pos.y), 1.0f, start);
+#undef TX
+#undef TY
+}
+
+static bool compile(const char *in, const char *out) {
+    LevelDesc desc;
+    if (!json_load_desc(in, &desc) || !level_bin_save(out, &desc)) {
+        fprintf(stderr, "%s: failed\n", in);
+        return false;
+    }
+
+    // Read it back through the runtime path before calling it done
+    LevelBinView view;
+    bool ok = level_bin_open(out, &view);
+    if (ok) {
+        printf("%s -> %s (\"%s\", %d planets)\n", in, out,
+               view.desc->name, view.desc->planet_count);
+        level_bin_close(&view);
+    } else {
+        fprintf(stderr, "%s: wrote an unreadable file\n", out);
+    }
+    return ok;
+}
+
+static bool compile_pack(const char *out, char **inputs, s32 count) {
+    if (count > LEVEL_PACK_MAX) {
+        fprintf(stderr, "%d levels, a pack holds at most %d\n", count, LEVEL_PACK_MAX);
+        return false;
+    }
+
+    LevelDesc     *descs  = calloc((size_t)MAX(count, 1), sizeof(LevelDesc));
+    u8            *thumbs = calloc((size_t)MAX(count, 1), LEVEL_THUMB_SIZE);
+    LevelPackItem *items  = calloc((size_t)MAX(count, 1), sizeof(LevelPackItem));
+    char         (*ids)[LEVEL_PACK_ID_MAX] = calloc((size_t)MAX(count, 1), LEVEL_PACK_ID_MAX);
+    bool ok = descs && thumbs && items && ids;
+
+    for (s32 i = 0; ok && i < count; i++) {
+        int stem_len;
+        const char *stem = path_stem(inputs[i], &stem_len);
+        snprintf(ids[i], LEVEL_PACK_ID_MAX, "%.*s", stem_len, stem);
+        if (!json_load_desc(inputs[i], &descs[i])) {
+            fprintf(stderr, "%s: failed\n", inputs[i]);
+            ok = false;
+            break;
+        }
+        render_thumb(&descs[i], &thumbs[(size_t)i * LEVEL_THUMB_SIZE]);
+        items[i] = (LevelPackItem){
+            .id    = ids[i],
+            .desc  = &descs[i],
+            .thumb = &thumbs[(size_t)i * LEVEL_THUMB_SIZE],
+        };
+    }
+    ok = ok && level_pack_save(out, items, count);
+
+    // Read back every level through the runtime path
+    const LevelPack *pack = ok ? level_pack_get(out) : NULL;
+    ok = ok && pack && pack->count == count;
+    for (s32 i = 0; ok && i < count; i++) {
+        char ref[512];
+        level_pack_ref(pack, i, ref, sizeof(ref));
+        LevelBytes bytes;
+        LevelDesc scratch;
+        ok = level_read(ref, &bytes) && level_parse(ref, bytes.data, bytes.size, &scratch);
+        if (ok) printf("%s -> %s#%s (\"%s\", difficulty %d)\n", inputs[i], out,
+                       pack->entries[i].id, pack->entries[i].name,
+                       pack->entries[i].difficulty);
+        level_bytes_free(&bytes);
+    }
+    if (!ok) fprintf(stderr, "%s: failed\n", out);
+
+    level_pack_release();
+    free(ids);
+    free(items);
+    free(thumbs);
+    free(descs);
+    return ok;
+}
+
+int main(int argc, char *argv[]) {
+    if (argc < 2) {
+        fprintf(stderr, "usage: %s [-o out.gbl] <level.json>...\n"
+                        "       %s -p out.gbp <level.json>...\n", argv[0], argv[0]);
+        return 2;
+    }
+
+    if (strcmp(argv[1], "-o") == 0) {
+        if (argc != 4) {
+            fprintf(stderr, "-o takes exactly one input\n");
+            return 2;
+        }
+        return compile(argv[3], argv[2]) ? 0 : 1;
+    }
+
+    if (strcmp(argv[1], "-p") == 0) {
+        if (argc < 3) {
+            fprintf(stderr, "-p needs an output path\n");
+            return 2;
+        }
+        return compile_pack(argv[2], &argv[3], argc - 3) ? 0 : 1;
+    }
+
+    int failures = 0;
+    for (int i = 1; i < argc; i++) {
+        char out[512];
+        output_path(out, sizeof(out), argv[i]);
+        if (!compile(argv[i], out)) failures++;
+    }
+    return failures ? 1 : 0;
+}
@@ -0,0 +1,136 @@
+#include "utils/jobs.h"
+#include "utils/profiler.h"
+#include <SDL3/SDL.h>
+
+#if defined(__EMSCRIPTEN__) && !defined(__EMSCRIPTEN_PTHREADS__)
+#define JOBS_INLINE_ONLY 1
+#endif
+
+typedef struct {
+    JobRangeFn    fn;
+    void         *ctx;
+    s32           count;
+    s32           chunk;
+    SDL_AtomicInt next;      // next chunk index to claim
+    SDL_AtomicInt active;    // workers still inside this batch
+} JobBatch;
+
+static struct {
+    SDL_Thread    *threads[JOBS_MAX_THREADS];
+    s32            thread_count;
+    SDL_Semaphore *wake;     // one post per worker per batch
+    SDL_Semaphore *done;     // posted by the last worker out
+    SDL_Mutex     *submit;   // one batch in flight at a time
+    SDL_AtomicInt  quit;
+    JobBatch       batch;
+} pool;
+
+static void run_chunks(JobBatch *b) {
+    s32 chunks = (b->count + b->chunk - 1) / b->chunk;
+    for (;;) {
+        s32 c = SDL_AddAtomicInt(&b->next, 1);
+        if (c >= chunks) break;
+        s32 begin = c * b->chunk;
+        s32 end   = MIN(begin + b->chunk, b->count);
+        b->fn(b->ctx, begin, end);
+    }
+}
+
+static int SDLCALL worker_main(void *data) {
+    (void)data;
+    for (;;) {
+        SDL_WaitSemaphore(pool.wake);
+        if (SDL_GetAtomicInt(&pool.quit)) break;
+
+        PROF_BEGIN("job");
+        run_chunks(&pool.batch);
+        PROF_END();
+
+        if (SDL_AddAtomicInt(&pool.batch.active, -1) == 1)
+            SDL_SignalSemaphore(pool.done);
+    }
+    return 0;
+}
+
+void jobs_init(s32 worker_count) {
+#ifdef JOBS_INLINE_ONLY
+    (void)worker_count;
+#else
+    if (pool.thread_count > 0) return;
+
+    if (worker_count <= 0)
+        worker_count = SDL_GetNumLogicalCPUCores() - 1;
+    worker_count = CLAMP(worker_count, 0, JOBS_MAX_THREADS);
+    if (worker_count == 0) return;
+
+    pool.wake   = SDL_CreateSemaphore(0);
+    pool.done   = SDL_CreateSemaphore(0);
+    pool.submit = SDL_CreateMutex();
+    if (!pool.wake || !pool.done || !pool.submit) {
+        SDL_Log("jobs_init: %s", SDL_GetError());
+        jobs_shutdown();
+        return;
+    }
+    SDL_SetAtomicInt(&pool.quit, 0);
+
+    for (s32 i = 0; i < worker_count; i++) {
+        SDL_Thread *t = SDL_CreateThread(worker_main, "job_worker", NULL);
+        if (!t) {
+            SDL_Log("jobs_init: thread %d failed: %s", i, SDL_GetError());
+            break;
+        }
+        pool.threads[pool.thread_count++] = t;
+    }
+#endif
+}
+
+void jobs_shutdown(void) {
+    SDL_SetAtomicInt(&pool.quit, 1);
+    for (s32 i = 0; i < pool.thread_count; i++)
+        SDL_SignalSemaphore(pool.wake);
+    for (s32 i = 0; i < pool.thread_count; i++)
+        SDL_WaitThread(pool.threads[i], NULL);
+    pool.thread_count = 0;
+
+    if (pool.wake)   SDL_DestroySemaphore(pool.wake);
+    if (pool.done)   SDL_DestroySemaphore(pool.done);
+    if (pool.submit) SDL_DestroyMutex(pool.submit);
+    pool.wake = pool.done = NULL;
+    pool.submit = NULL;
+}
+
+s32 jobs_worker_count(void) {
+    return pool.thread_count;
+}
+
+void jobs_parallel_for(s32 count, s32 chunk, JobRangeFn fn, void *ctx) {
+    if (count <= 0) return;
+    if (chunk <= 0) chunk = 1;
+
+    // Not worth waking anyone for a single chunk
+    if (pool.thread_count == 0 || count <= chunk) {
+        fn(ctx, 0, count);
+        return;
+    }
+
+    SDL_LockMutex(pool.submit);
+
+    JobBatch *b = &pool.batch;
+    b->fn    = fn;
+    b->ctx   = ctx;
+    b->count = count;
+    b->chunk = chunk;
+    SDL_SetAtomicInt(&b->next, 0);
+
+    s32 chunks = (count + chunk - 1) / chunk;
+    s32 helpers = MIN(pool.thread_count, chunks - 1);
+    SDL_SetAtomicInt(&b->active, helpers);
+    for (s32 i = 0; i < helpers; i++)
+        SDL_SignalSemaphore(pool.wake);
+
+    run_chunks(b);
+    if (helpers > 0)
+        SDL_WaitSemaphore(pool.done);
+
+    SDL_UnlockMutex(pool.submit);
+}
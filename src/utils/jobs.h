@@ -0,0 +1,23 @@
+#pragma once
+#include "utils/q_util.h"
+
+// Fixed worker pool for data-parallel loops.
+//
+// jobs_parallel_for splits [0, count) into chunks and runs them on the
+// workers and the calling thread, returning when all are done. On builds
+// without threads (Emscripten without pthreads) or before jobs_init it
+// runs the whole range inline, so callers never need a fallback path.
+
+#define JOBS_MAX_THREADS 16
+
+typedef void (*JobRangeFn)(void *ctx, s32 begin, s32 end);
+
+// Spawn `worker_count` threads (<= 0: logical cores - 1)
+void jobs_init(s32 worker_count);
+void jobs_shutdown(void);
+// Worker threads, not counting the caller
+s32  jobs_worker_count(void);
+
+// Call fn(ctx, begin, end) over [0, count) in chunks of `chunk` items.
+// Not re-entrant: fn must not call jobs_parallel_for.
+void jobs_parallel_for(s32 count, s32 chunk, JobRangeFn fn, void *ctx);
@@ -0,0 +1,177 @@
+#include "utils/mem_track.h"
+#include <SDL3/SDL.h>
+#include <box2d/box2d.h>
+#include <stdlib.h>
+
+#ifdef __EMSCRIPTEN__
+#include <emscripten/heap.h>
+#endif
+
+// SDL's original allocators are thin wrappers over the C runtime, so the
+// block size of an SDL allocation can be recovered from the libc heap.
+#if defined(_WIN32)
+#include <malloc.h>
+#define MEM_USABLE_SIZE(p) _msize(p)
+#elif defined(__APPLE__)
+#include <malloc/malloc.h>
+#define MEM_USABLE_SIZE(p) malloc_size(p)
+#elif defined(__linux__) || defined(__EMSCRIPTEN__)
+#include <malloc.h>
+#define MEM_USABLE_SIZE(p) malloc_usable_size(p)
+#else
+#define MEM_USABLE_SIZE(p) ((size_t)0)  // counts only, no byte totals
+#endif
+
+static SDL_AtomicInt live_bytes[MEM_TAG_COUNT];
+static SDL_AtomicInt peak_bytes[MEM_TAG_COUNT];
+static SDL_AtomicInt live_allocs[MEM_TAG_COUNT];
+static SDL_AtomicInt frame_allocs[MEM_TAG_COUNT];
+static s32 last_frame_allocs[MEM_TAG_COUNT];  // main thread only
+
+static u64 heap_size;
+static s32 heap_growths;
+
+static const char *tag_names[MEM_TAG_COUNT] = {
+    [MEM_TAG_SDL]   = "SDL",
+    [MEM_TAG_BOX2D] = "Box2D",
+};
+
+static void note_alloc(MemTag tag, size_t bytes) {
+    int b = (int)bytes;
+    int live = SDL_AddAtomicInt(&live_bytes[tag], b) + b;
+    int peak = SDL_GetAtomicInt(&peak_bytes[tag]);
+    while (live > peak && !SDL_CompareAndSwapAtomicInt(&peak_bytes[tag], peak, live))
+        peak = SDL_GetAtomicInt(&peak_bytes[tag]);
+
+    SDL_AddAtomicInt(&live_allocs[tag], 1);
+    SDL_AddAtomicInt(&frame_allocs[tag], 1);
+}
+
+static void note_free(MemTag tag, size_t bytes) {
+    SDL_AddAtomicInt(&live_bytes[tag], -(int)bytes);
+    SDL_AddAtomicInt(&live_allocs[tag], -1);
+}
+
+// ---------------------------------------------------------------------------
+// Header-prefixed aligned allocations (Box2D)
+// ---------------------------------------------------------------------------
+
+// Stored immediately before the pointer handed out
+typedef struct {
+    void  *raw;
+    size_t size;
+} AllocHeader;
+
+static void *tracked_alloc(MemTag tag, size_t size, size_t align) {
+    if (align < sizeof(AllocHeader)) align = sizeof(AllocHeader);
+
+    u8 *raw = malloc(size + align + sizeof(AllocHeader));
+    if (!raw) return NULL;
+
+    uintptr_t base = (uintptr_t)(raw + sizeof(AllocHeader));
+    u8 *user = (u8 *)((base + align - 1) & ~(uintptr_t)(align - 1));
+
+    AllocHeader *h = (AllocHeader *)user - 1;
+    h->raw  = raw;
+    h->size = size;
+
+    note_alloc(tag, size);
+    return user;
+}
+
+static void tracked_free(MemTag tag, void *ptr) {
+    if (!ptr) return;
+    AllocHeader *h = (AllocHeader *)ptr - 1;
+    note_free(tag, h->size);
+    free(h->raw);
+}
+
+static void *box2d_alloc(unsigned int size, int alignment) {
+    return tracked_alloc(MEM_TAG_BOX2D, size, (size_t)alignment);
+}
+static void box2d_free(void *ptr) { tracked_free(MEM_TAG_BOX2D, ptr); }
+
+// ---------------------------------------------------------------------------
+// SDL wrappers (delegate to SDL's original functions)
+// ---------------------------------------------------------------------------
+
+static SDL_malloc_func  sdl_malloc;
+static SDL_calloc_func  sdl_calloc;
+static SDL_realloc_func sdl_realloc;
+static SDL_free_func    sdl_free;
+
+static void *SDLCALL sdl_track_malloc(size_t size) {
+    void *p = sdl_malloc(size);
+    if (p) note_alloc(MEM_TAG_SDL, MEM_USABLE_SIZE(p));
+    return p;
+}
+
+static void *SDLCALL sdl_track_calloc(size_t nmemb, size_t size) {
+    void *p = sdl_calloc(nmemb, size);
+    if (p) note_alloc(MEM_TAG_SDL, MEM_USABLE_SIZE(p));
+    return p;
+}
+
+static void *SDLCALL sdl_track_realloc(void *mem, size_t size) {
+    size_t old = mem ? MEM_USABLE_SIZE(mem) : 0;
+    void *p = sdl_realloc(mem, size);
+    if (!p) return NULL;
+    if (mem) note_free(MEM_TAG_SDL, old);
+    note_alloc(MEM_TAG_SDL, MEM_USABLE_SIZE(p));
+    return p;
+}
+
+static void SDLCALL sdl_track_free(void *mem) {
+    if (!mem) return;
+    note_free(MEM_TAG_SDL, MEM_USABLE_SIZE(mem));
+    sdl_free(mem);
+}
+
+// ---------------------------------------------------------------------------
+// Public API
+// ---------------------------------------------------------------------------
+
+void mem_track_install(void) {
+    b2SetAllocator(box2d_alloc, box2d_free);
+
+    SDL_GetOriginalMemoryFunctions(&sdl_malloc, &sdl_calloc, &sdl_realloc, &sdl_free);
+    if (!SDL_SetMemoryFunctions(sdl_track_malloc, sdl_track_calloc,
+                                sdl_track_realloc, sdl_track_free))
+        SDL_Log("mem_track: SDL_SetMemoryFunctions failed: %s", SDL_GetError());
+
+#ifdef __EMSCRIPTEN__
+    heap_size = emscripten_get_heap_size();
+#endif
+}
+
+void mem_track_frame_end(void) {
+    for (int t = 0; t < MEM_TAG_COUNT; t++)
+        last_frame_allocs[t] = SDL_SetAtomicInt(&frame_allocs[t], 0);
+
+#ifdef __EMSCRIPTEN__
+    u64 size = emscripten_get_heap_size();
+    if (size != heap_size) {
+        heap_growths++;
+        SDL_Log("mem_track: heap grew %llu -> %llu KB (SDL %d KB, Box2D %d KB)",
+                (unsigned long long)(heap_size / 1024), (unsigned long long)(size / 1024),
+                SDL_GetAtomicInt(&live_bytes[MEM_TAG_SDL]) / 1024,
+                SDL_GetAtomicInt(&live_bytes[MEM_TAG_BOX2D]) / 1024);
+        heap_size = size;
+    }
+#endif
+}
+
+void mem_track_stats(MemStats *out) {
+    for (int t = 0; t < MEM_TAG_COUNT; t++) {
+        out->tags[t].live_bytes   = SDL_GetAtomicInt(&live_bytes[t]);
+        out->tags[t].peak_bytes   = SDL_GetAtomicInt(&peak_bytes[t]);
+        out->tags[t].live_allocs  = SDL_GetAtomicInt(&live_allocs[t]);
+        out->tags[t].frame_allocs = last_frame_allocs[t];
+    }
+    out->heap_size    = heap_size;
+    out->heap_growths = heap_growths;
+}
+
+const char *mem_tag_name(MemTag tag) {
+    return (tag >= 0 && tag < MEM_TAG_COUNT) ? tag_names[tag] : "?";
+}
@@ -0,0 +1,37 @@
+#pragma once
+#include <stdbool.h>
+#include "utils/q_util.h"
+
+// Per-subsystem memory accounting.
+//
+// mem_track_install() routes SDL and Box2D allocations through counting
+// wrappers tagged by subsystem. It must run before Box2D creates a world;
+// SDL allocations made before the call are not counted (their frees are, so
+// SDL live bytes start slightly low).
+
+typedef enum {
+    MEM_TAG_SDL,
+    MEM_TAG_BOX2D,
+    MEM_TAG_COUNT,
+} MemTag;
+
+typedef struct {
+    s32 live_bytes;
+    s32 peak_bytes;
+    s32 live_allocs;
+    s32 frame_allocs;   // allocations during the last completed frame
+} MemTagStats;
+
+typedef struct {
+    MemTagStats tags[MEM_TAG_COUNT];
+    u64 heap_size;      // WASM linear memory size (0 on native)
+    s32 heap_growths;   // memory growth events since install
+} MemStats;
+
+void mem_track_install(void);
+
+// Latch per-frame allocation counts and detect WASM heap growth.
+void mem_track_frame_end(void);
+
+void mem_track_stats(MemStats *out);
+const char *mem_tag_name(MemTag tag);
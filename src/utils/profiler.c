@@ -0,0 +1,216 @@
+#include "utils/profiler.h"
+#include <SDL3/SDL.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#if defined(_MSC_VER)
+#define PROF_TLS __declspec(thread)
+#else
+#define PROF_TLS _Thread_local
+#endif
+
+typedef enum {
+    PROF_EVENT_SPAN,
+    PROF_EVENT_COUNTER,
+} ProfEventKind;
+
+typedef struct {
+    const char *name;
+    u64 start;
+    union {
+        u64 end;     // PROF_EVENT_SPAN
+        f64 value;   // PROF_EVENT_COUNTER
+    };
+    u16 depth;
+    u16 kind;
+} ProfEvent;
+
+typedef struct {
+    SDL_ThreadID tid;
+    bool is_main;                         // slots go in registration order
+    u32  head;                            // total events written (wraps via mask)
+    u32  depth;
+    u64  stack_start[PROF_MAX_DEPTH];
+    const char *stack_name[PROF_MAX_DEPTH];
+    ProfEvent events[PROF_RING_EVENTS];
+} ProfThread;
+
+static ProfThread *threads[PROF_MAX_THREADS];
+static SDL_AtomicInt thread_count;
+
+// Frame history (main thread only)
+static f32 frame_ms[PROF_FRAME_HISTORY];
+static s32 frame_head;   // next write slot
+static s32 frame_count;
+
+#if GB_PROFILE
+
+static PROF_TLS ProfThread *tls_thread;
+static PROF_TLS bool tls_overflow;   // registration failed, drop markers
+
+static ProfThread *prof_thread(void) {
+    if (tls_thread) return tls_thread;
+    if (tls_overflow) return NULL;
+
+    int slot = SDL_AddAtomicInt(&thread_count, 1);
+    if (slot >= PROF_MAX_THREADS) {
+        SDL_AddAtomicInt(&thread_count, -1);
+        tls_overflow = true;
+        return NULL;
+    }
+
+    ProfThread *t = SDL_calloc(1, sizeof(ProfThread));
+    if (!t) {
+        tls_overflow = true;
+        return NULL;
+    }
+    t->tid = SDL_GetCurrentThreadID();
+    t->is_main = SDL_IsMainThread();
+    threads[slot] = t;
+    tls_thread = t;
+    return t;
+}
+
+void prof_begin(const char *name) {
+    ProfThread *t = prof_thread();
+    if (!t) return;
+
+    if (t->depth < PROF_MAX_DEPTH) {
+        t->stack_name[t->depth]  = name;
+        t->stack_start[t->depth] = SDL_GetPerformanceCounter();
+    }
+    t->depth++;
+}
+
+void prof_end(void) {
+    ProfThread *t = tls_thread;
+    if (!t || t->depth == 0) return;
+
+    u64 end = SDL_GetPerformanceCounter();
+    t->depth--;
+    if (t->depth >= PROF_MAX_DEPTH) return;  // too deep, was never recorded
+
+    ProfEvent *e = &t->events[t->head & (PROF_RING_EVENTS - 1)];
+    e->name  = t->stack_name[t->depth];
+    e->start = t->stack_start[t->depth];
+    e->end   = end;
+    e->depth = (u16)t->depth;
+    e->kind  = PROF_EVENT_SPAN;
+    t->head++;
+}
+
+void prof_counter(const char *name, f64 value) {
+    ProfThread *t = prof_thread();
+    if (!t) return;
+
+    ProfEvent *e = &t->events[t->head & (PROF_RING_EVENTS - 1)];
+    e->name  = name;
+    e->start = SDL_GetPerformanceCounter();
+    e->value = value;
+    e->depth = 0;
+    e->kind  = PROF_EVENT_COUNTER;
+    t->head++;
+}
+
+#endif // GB_PROFILE
+
+void prof_frame_end(f32 ms) {
+    frame_ms[frame_head] = ms;
+    frame_head = (frame_head + 1) % PROF_FRAME_HISTORY;
+    if (frame_count < PROF_FRAME_HISTORY) frame_count++;
+}
+
+static int cmp_f32(const void *a, const void *b) {
+    f32 fa = *(const f32 *)a;
+    f32 fb = *(const f32 *)b;
+    return (fa > fb) - (fa < fb);
+}
+
+void prof_frame_stats(ProfFrameStats *out) {
+    memset(out, 0, sizeof(*out));
+    out->count = frame_count;
+    if (frame_count == 0) return;
+
+    // Unroll ring into chronological order
+    s32 first = (frame_count < PROF_FRAME_HISTORY) ? 0 : frame_head;
+    for (s32 i = 0; i < frame_count; i++)
+        out->history[i] = frame_ms[(first + i) % PROF_FRAME_HISTORY];
+
+    f32 sorted[PROF_FRAME_HISTORY];
+    memcpy(sorted, out->history, sizeof(f32) * (size_t)frame_count);
+    qsort(sorted, (size_t)frame_count, sizeof(f32), cmp_f32);
+
+    s32 last = frame_count - 1;
+    out->p50 = sorted[(s32)(0.50f * last)];
+    out->p95 = sorted[(s32)(0.95f * last)];
+    out->p99 = sorted[(s32)(0.99f * last)];
+    out->max = sorted[last];
+
+    f32 bin_w = PROF_HIST_MAX_MS / PROF_HIST_BINS;
+    for (s32 i = 0; i < frame_count; i++) {
+        s32 bin = (s32)(out->history[i] / bin_w);
+        out->hist[CLAMP(bin, 0, PROF_HIST_BINS - 1)] += 1.0f;
+    }
+}
+
+bool prof_dump_trace(const char *path) {
+    FILE *f = fopen(path, "w");
+    if (!f) {
+        SDL_Log("prof_dump_trace: failed to open '%s'", path);
+        return false;
+    }
+
+    f64 us_per_tick = 1e6 / (f64)SDL_GetPerformanceFrequency();
+    int n_threads = SDL_GetAtomicInt(&thread_count);
+    if (n_threads > PROF_MAX_THREADS) n_threads = PROF_MAX_THREADS;
+
+    fputs("{\"traceEvents\":[\n", f);
+    bool first = true;
+    u32 written = 0;
+
+    for (int ti = 0; ti < n_threads; ti++) {
+        const ProfThread *t = threads[ti];
+        if (!t) continue;
+
+        fprintf(f, "%s{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":%d,"
+                   "\"args\":{\"name\":\"%s\"}}",
+                first ? "" : ",\n", ti, t->is_main ? "main" : "worker");
+        first = false;
+
+        // Walk the ring oldest-first; a writer may race us on worker threads,
+        // which at worst tears the newest event.
+        u32 head  = t->head;
+        u32 count = head < PROF_RING_EVENTS ? head : PROF_RING_EVENTS;
+        for (u32 i = head - count; i != head; i++) {
+            const ProfEvent *e = &t->events[i & (PROF_RING_EVENTS - 1)];
+            if (e->kind == PROF_EVENT_COUNTER) {
+                fprintf(f, ",\n{\"name\":\"%s\",\"ph\":\"C\",\"pid\":1,\"tid\":%d,"
+                           "\"ts\":%.3f,\"args\":{\"value\":%g}}",
+                        e->name, ti, (f64)e->start * us_per_tick, e->value);
+            } else {
+                fprintf(f, ",\n{\"name\":\"%s\",\"ph\":\"X\",\"pid\":1,\"tid\":%d,"
+                           "\"ts\":%.3f,\"dur\":%.3f}",
+                        e->name, ti,
+                        (f64)e->start * us_per_tick,
+                        (f64)(e->end - e->start) * us_per_tick);
+            }
+            written++;
+        }
+    }
+
+    fputs("\n],\"displayTimeUnit\":\"ms\"}\n", f);
+    fclose(f);
+
+    SDL_Log("prof_dump_trace: wrote %u events from %d threads to '%s'",
+            written, n_threads, path);
+    return true;
+}
+
+void prof_shutdown(void) {
+    for (int i = 0; i < PROF_MAX_THREADS; i++) {
+        SDL_free(threads[i]);
+        threads[i] = NULL;
+    }
+    SDL_SetAtomicInt(&thread_count, 0);
+}
@@ -0,0 +1,57 @@
+#pragma once
+#include <stdbool.h>
+#include "utils/q_util.h"
+
+// Hierarchical scoped profiler.
+//
+// PROF_BEGIN/PROF_END pairs record nested timing markers into a per-thread
+// ring buffer (no locks, no allocation after a thread's first marker).
+// Markers are dumped as Chrome/Perfetto trace JSON with prof_dump_trace().
+//
+// Build with -DGB_PROFILE=0 to compile every marker out.
+
+#ifndef GB_PROFILE
+#define GB_PROFILE 1
+#endif
+
+#define PROF_MAX_THREADS    16
+#define PROF_RING_EVENTS    8192   // per-thread ring capacity (power of two)
+#define PROF_MAX_DEPTH      32     // deepest nesting tracked per thread
+#define PROF_FRAME_HISTORY  512    // frames kept for percentile stats
+#define PROF_HIST_BINS      40     // frame-time histogram buckets
+#define PROF_HIST_MAX_MS    40.0f  // upper edge of the last bucket
+
+typedef struct {
+    f32 p50, p95, p99;
+    f32 max;
+    s32 count;                     // frames in the history window
+    f32 hist[PROF_HIST_BINS];      // frame count per bucket
+    f32 history[PROF_FRAME_HISTORY]; // frame times, oldest first
+} ProfFrameStats;
+
+#if GB_PROFILE
+// `name` must outlive the profiler (use string literals).
+void prof_begin(const char *name);
+void prof_end(void);
+// Sample a named value; shows up as a counter track in the trace.
+void prof_counter(const char *name, f64 value);
+#define PROF_BEGIN(name)          prof_begin(name)
+#define PROF_END()                prof_end()
+#define PROF_COUNTER(name, value) prof_counter(name, (f64)(value))
+#else
+#define PROF_BEGIN(name)          ((void)0)
+#define PROF_END()                ((void)0)
+#define PROF_COUNTER(name, value) ((void)0)
+#endif
+
+// Record one completed frame's wall time.
+void prof_frame_end(f32 frame_ms);
+
+// Percentiles + histogram over the frame history window.
+void prof_frame_stats(ProfFrameStats *out);
+
+// Write every thread's ring buffer as Chrome trace JSON ("X"/"C" events).
+bool prof_dump_trace(const char *path);
+
+// Free per-thread buffers (call once at shutdown, after workers exit).
+void prof_shutdown(void);
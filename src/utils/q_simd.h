@@ -0,0 +1,285 @@
+#pragma once
+#include "utils/q_util.h"
+
+/* ---- 4-wide f32 / u32 vectors ----
+ *
+ * One small wrapper over SSE2, NEON and wasm simd128 with a scalar
+ * fallback, so hot loops are written once. Define Q_SIMD_SCALAR to force
+ * the fallback. Loads and stores are unaligned. u32x4 lanes double as
+ * all-ones/all-zero masks for f32x4_select.
+ */
+
+#if !defined(Q_SIMD_SCALAR) && (defined(__SSE2__) || defined(_M_X64) || \
+    (defined(_M_IX86_FP) && _M_IX86_FP >= 2))
+#define Q_SIMD_SSE2 1
+#include <emmintrin.h>
+#if defined(__SSE4_1__)
+#include <smmintrin.h>
+#endif
+typedef __m128  f32x4;
+typedef __m128i u32x4;
+#elif !defined(Q_SIMD_SCALAR) && (defined(__ARM_NEON) || defined(__ARM_NEON__))
+#define Q_SIMD_NEON 1
+#include <arm_neon.h>
+typedef float32x4_t f32x4;
+typedef uint32x4_t  u32x4;
+#elif !defined(Q_SIMD_SCALAR) && defined(__wasm_simd128__)
+#define Q_SIMD_WASM 1
+#include <wasm_simd128.h>
+typedef v128_t f32x4;
+typedef v128_t u32x4;
+#else
+#define Q_SIMD_SCALAR_IMPL 1
+#include <math.h>
+#include <string.h>
+typedef struct { f32 v[4]; } f32x4;
+typedef struct { u32 v[4]; } u32x4;
+#endif
+
+#define F32X4_WIDTH 4
+
+#if Q_SIMD_SSE2
+
+static inline f32x4 f32x4_load(const f32 *p)           { return _mm_loadu_ps(p); }
+static inline void  f32x4_store(f32 *p, f32x4 a)       { _mm_storeu_ps(p, a); }
+static inline f32x4 f32x4_set1(f32 s)                  { return _mm_set1_ps(s); }
+static inline f32x4 f32x4_set(f32 a, f32 b, f32 c, f32 d) { return _mm_setr_ps(a, b, c, d); }
+static inline f32x4 f32x4_add(f32x4 a, f32x4 b)        { return _mm_add_ps(a, b); }
+static inline f32x4 f32x4_sub(f32x4 a, f32x4 b)        { return _mm_sub_ps(a, b); }
+static inline f32x4 f32x4_mul(f32x4 a, f32x4 b)        { return _mm_mul_ps(a, b); }
+static inline f32x4 f32x4_div(f32x4 a, f32x4 b)        { return _mm_div_ps(a, b); }
+static inline f32x4 f32x4_min(f32x4 a, f32x4 b)        { return _mm_min_ps(a, b); }
+static inline f32x4 f32x4_max(f32x4 a, f32x4 b)        { return _mm_max_ps(a, b); }
+static inline f32x4 f32x4_sqrt(f32x4 a)                { return _mm_sqrt_ps(a); }
+static inline f32x4 f32x4_abs(f32x4 a) {
+    return _mm_and_ps(a, _mm_castsi128_ps(_mm_set1_epi32(0x7FFFFFFF)));
+}
+static inline f32x4 f32x4_floor(f32x4 a) {
+#if defined(__SSE4_1__)
+    return _mm_floor_ps(a);
+#else
+    // Truncate, then step down where that rounded up (negative inputs)
+    f32x4 t = _mm_cvtepi32_ps(_mm_cvttps_epi32(a));
+    return _mm_sub_ps(t, _mm_and_ps(_mm_cmpgt_ps(t, a), _mm_set1_ps(1.0f)));
+#endif
+}
+static inline f32x4 f32x4_select(u32x4 m, f32x4 a, f32x4 b) {
+    f32x4 mf = _mm_castsi128_ps(m);
+    return _mm_or_ps(_mm_and_ps(mf, a), _mm_andnot_ps(mf, b));
+}
+static inline f32x4 f32x4_xor_bits(f32x4 a, u32x4 b)   { return _mm_xor_ps(a, _mm_castsi128_ps(b)); }
+
+static inline u32x4 u32x4_set1(u32 s)                  { return _mm_set1_epi32((int)s); }
+static inline u32x4 u32x4_add(u32x4 a, u32x4 b)        { return _mm_add_epi32(a, b); }
+static inline u32x4 u32x4_and(u32x4 a, u32x4 b)        { return _mm_and_si128(a, b); }
+static inline u32x4 u32x4_or(u32x4 a, u32x4 b)         { return _mm_or_si128(a, b); }
+static inline u32x4 u32x4_xor(u32x4 a, u32x4 b)        { return _mm_xor_si128(a, b); }
+static inline u32x4 u32x4_shl(u32x4 a, int n)          { return _mm_slli_epi32(a, n); }
+static inline u32x4 u32x4_shr(u32x4 a, int n)          { return _mm_srli_epi32(a, n); }
+static inline u32x4 u32x4_eq(u32x4 a, u32x4 b)         { return _mm_cmpeq_epi32(a, b); }
+static inline u32x4 u32x4_mul(u32x4 a, u32x4 b) {
+#if defined(__SSE4_1__)
+    return _mm_mullo_epi32(a, b);
+#else
+    // No 32-bit mullo before SSE4.1: multiply even and odd lanes apart
+    __m128i even = _mm_mul_epu32(a, b);
+    __m128i odd  = _mm_mul_epu32(_mm_srli_si128(a, 4), _mm_srli_si128(b, 4));
+    return _mm_unpacklo_epi32(_mm_shuffle_epi32(even, _MM_SHUFFLE(0, 0, 2, 0)),
+                              _mm_shuffle_epi32(odd,  _MM_SHUFFLE(0, 0, 2, 0)));
+#endif
+}
+// Integral floats (e.g. from f32x4_floor) to two's-complement lanes
+static inline u32x4 u32x4_from_f32(f32x4 a)            { return _mm_cvttps_epi32(a); }
+
+#elif Q_SIMD_NEON
+
+static inline f32x4 f32x4_load(const f32 *p)           { return vld1q_f32(p); }
+static inline void  f32x4_store(f32 *p, f32x4 a)       { vst1q_f32(p, a); }
+static inline f32x4 f32x4_set1(f32 s)                  { return vdupq_n_f32(s); }
+static inline f32x4 f32x4_set(f32 a, f32 b, f32 c, f32 d) {
+    f32 t[4] = { a, b, c, d };
+    return vld1q_f32(t);
+}
+static inline f32x4 f32x4_add(f32x4 a, f32x4 b)        { return vaddq_f32(a, b); }
+static inline f32x4 f32x4_sub(f32x4 a, f32x4 b)        { return vsubq_f32(a, b); }
+static inline f32x4 f32x4_mul(f32x4 a, f32x4 b)        { return vmulq_f32(a, b); }
+static inline f32x4 f32x4_min(f32x4 a, f32x4 b)        { return vminq_f32(a, b); }
+static inline f32x4 f32x4_max(f32x4 a, f32x4 b)        { return vmaxq_f32(a, b); }
+#if defined(__aarch64__) || defined(_M_ARM64)
+static inline f32x4 f32x4_div(f32x4 a, f32x4 b)        { return vdivq_f32(a, b); }
+static inline f32x4 f32x4_sqrt(f32x4 a)                { return vsqrtq_f32(a); }
+#else
+// ARMv7 NEON has no divide/sqrt: reciprocal estimate + two Newton steps
+static inline f32x4 f32x4_div(f32x4 a, f32x4 b) {
+    float32x4_t r = vrecpeq_f32(b);
+    r = vmulq_f32(vrecpsq_f32(b, r), r);
+    r = vmulq_f32(vrecpsq_f32(b, r), r);
+    return vmulq_f32(a, r);
+}
+static inline f32x4 f32x4_sqrt(f32x4 a) {
+    float32x4_t r = vrsqrteq_f32(a);
+    r = vmulq_f32(vrsqrtsq_f32(vmulq_f32(a, r), r), r);
+    r = vmulq_f32(vrsqrtsq_f32(vmulq_f32(a, r), r), r);
+    // sqrt(a) = a * rsqrt(a); mask a == 0 (rsqrt is inf there)
+    uint32x4_t nz = vcgtq_f32(a, vdupq_n_f32(0.0f));
+    return vreinterpretq_f32_u32(vandq_u32(nz, vreinterpretq_u32_f32(vmulq_f32(a, r))));
+}
+#endif
+static inline f32x4 f32x4_abs(f32x4 a)                 { return vabsq_f32(a); }
+#if defined(__aarch64__) || defined(_M_ARM64)
+static inline f32x4 f32x4_floor(f32x4 a)               { return vrndmq_f32(a); }
+#else
+static inline f32x4 f32x4_floor(f32x4 a) {
+    float32x4_t t = vcvtq_f32_s32(vcvtq_s32_f32(a));
+    uint32x4_t up = vcgtq_f32(t, a);
+    return vsubq_f32(t, vreinterpretq_f32_u32(vandq_u32(up, vreinterpretq_u32_f32(vdupq_n_f32(1.0f)))));
+}
+#endif
+static inline f32x4 f32x4_select(u32x4 m, f32x4 a, f32x4 b) { return vbslq_f32(m, a, b); }
+static inline f32x4 f32x4_xor_bits(f32x4 a, u32x4 b) {
+    return vreinterpretq_f32_u32(veorq_u32(vreinterpretq_u32_f32(a), b));
+}
+
+static inline u32x4 u32x4_set1(u32 s)                  { return vdupq_n_u32(s); }
+static inline u32x4 u32x4_add(u32x4 a, u32x4 b)        { return vaddq_u32(a, b); }
+static inline u32x4 u32x4_and(u32x4 a, u32x4 b)        { return vandq_u32(a, b); }
+static inline u32x4 u32x4_or(u32x4 a, u32x4 b)         { return vorrq_u32(a, b); }
+static inline u32x4 u32x4_xor(u32x4 a, u32x4 b)        { return veorq_u32(a, b); }
+static inline u32x4 u32x4_shl(u32x4 a, int n)          { return vshlq_u32(a, vdupq_n_s32(n)); }
+static inline u32x4 u32x4_shr(u32x4 a, int n)          { return vshlq_u32(a, vdupq_n_s32(-n)); }
+static inline u32x4 u32x4_eq(u32x4 a, u32x4 b)         { return vceqq_u32(a, b); }
+static inline u32x4 u32x4_mul(u32x4 a, u32x4 b)        { return vmulq_u32(a, b); }
+static inline u32x4 u32x4_from_f32(f32x4 a)            { return vreinterpretq_u32_s32(vcvtq_s32_f32(a)); }
+
+#elif Q_SIMD_WASM
+
+static inline f32x4 f32x4_load(const f32 *p)           { return wasm_v128_load(p); }
+static inline void  f32x4_store(f32 *p, f32x4 a)       { wasm_v128_store(p, a); }
+static inline f32x4 f32x4_set1(f32 s)                  { return wasm_f32x4_splat(s); }
+static inline f32x4 f32x4_set(f32 a, f32 b, f32 c, f32 d) { return wasm_f32x4_make(a, b, c, d); }
+static inline f32x4 f32x4_add(f32x4 a, f32x4 b)        { return wasm_f32x4_add(a, b); }
+static inline f32x4 f32x4_sub(f32x4 a, f32x4 b)        { return wasm_f32x4_sub(a, b); }
+static inline f32x4 f32x4_mul(f32x4 a, f32x4 b)        { return wasm_f32x4_mul(a, b); }
+static inline f32x4 f32x4_div(f32x4 a, f32x4 b)        { return wasm_f32x4_div(a, b); }
+static inline f32x4 f32x4_min(f32x4 a, f32x4 b)        { return wasm_f32x4_pmin(a, b); }
+static inline f32x4 f32x4_max(f32x4 a, f32x4 b)        { return wasm_f32x4_pmax(a, b); }
+static inline f32x4 f32x4_sqrt(f32x4 a)                { return wasm_f32x4_sqrt(a); }
+static inline f32x4 f32x4_abs(f32x4 a)                 { return wasm_f32x4_abs(a); }
+static inline f32x4 f32x4_floor(f32x4 a)               { return wasm_f32x4_floor(a); }
+static inline f32x4 f32x4_select(u32x4 m, f32x4 a, f32x4 b) { return wasm_v128_bitselect(a, b, m); }
+static inline f32x4 f32x4_xor_bits(f32x4 a, u32x4 b)   { return wasm_v128_xor(a, b); }
+
+static inline u32x4 u32x4_set1(u32 s)                  { return wasm_i32x4_splat((int)s); }
+static inline u32x4 u32x4_add(u32x4 a, u32x4 b)        { return wasm_i32x4_add(a, b); }
+static inline u32x4 u32x4_and(u32x4 a, u32x4 b)        { return wasm_v128_and(a, b); }
+static inline u32x4 u32x4_or(u32x4 a, u32x4 b)         { return wasm_v128_or(a, b); }
+static inline u32x4 u32x4_xor(u32x4 a, u32x4 b)        { return wasm_v128_xor(a, b); }
+static inline u32x4 u32x4_shl(u32x4 a, int n)          { return wasm_i32x4_shl(a, n); }
+static inline u32x4 u32x4_shr(u32x4 a, int n)          { return wasm_u32x4_shr(a, n); }
+static inline u32x4 u32x4_eq(u32x4 a, u32x4 b)         { return wasm_i32x4_eq(a, b); }
+static inline u32x4 u32x4_mul(u32x4 a, u32x4 b)        { return wasm_i32x4_mul(a, b); }
+static inline u32x4 u32x4_from_f32(f32x4 a)            { return wasm_i32x4_trunc_sat_f32x4(a); }
+
+#else
+
+#define F32X4_MAP2(name, expr)                                         \
+    static inline f32x4 name(f32x4 a, f32x4 b) {                       \
+        f32x4 r;                                                       \
+        for (int i = 0; i < 4; i++) r.v[i] = (expr);                   \
+        return r;                                                      \
+    }
+
+static inline f32x4 f32x4_load(const f32 *p) {
+    f32x4 r = {{ p[0], p[1], p[2], p[3] }};
+    return r;
+}
+static inline void f32x4_store(f32 *p, f32x4 a) {
+    for (int i = 0; i < 4; i++) p[i] = a.v[i];
+}
+static inline f32x4 f32x4_set1(f32 s) {
+    f32x4 r = {{ s, s, s, s }};
+    return r;
+}
+static inline f32x4 f32x4_set(f32 a, f32 b, f32 c, f32 d) {
+    f32x4 r = {{ a, b, c, d }};
+    return r;
+}
+F32X4_MAP2(f32x4_add, a.v[i] + b.v[i])
+F32X4_MAP2(f32x4_sub, a.v[i] - b.v[i])
+F32X4_MAP2(f32x4_mul, a.v[i] * b.v[i])
+F32X4_MAP2(f32x4_div, a.v[i] / b.v[i])
+F32X4_MAP2(f32x4_min, a.v[i] < b.v[i] ? a.v[i] : b.v[i])
+F32X4_MAP2(f32x4_max, a.v[i] > b.v[i] ? a.v[i] : b.v[i])
+static inline f32x4 f32x4_sqrt(f32x4 a) {
+    f32x4 r;
+    for (int i = 0; i < 4; i++) r.v[i] = sqrtf(a.v[i]);
+    return r;
+}
+static inline f32x4 f32x4_abs(f32x4 a) {
+    f32x4 r;
+    for (int i = 0; i < 4; i++) r.v[i] = fabsf(a.v[i]);
+    return r;
+}
+static inline f32x4 f32x4_floor(f32x4 a) {
+    f32x4 r;
+    for (int i = 0; i < 4; i++) r.v[i] = floorf(a.v[i]);
+    return r;
+}
+static inline f32x4 f32x4_select(u32x4 m, f32x4 a, f32x4 b) {
+    f32x4 r;
+    for (int i = 0; i < 4; i++) r.v[i] = m.v[i] ? a.v[i] : b.v[i];
+    return r;
+}
+static inline f32x4 f32x4_xor_bits(f32x4 a, u32x4 b) {
+    f32x4 r;
+    for (int i = 0; i < 4; i++) {
+        u32 u;
+        memcpy(&u, &a.v[i], sizeof(u));
+        u ^= b.v[i];
+        memcpy(&r.v[i], &u, sizeof(u));
+    }
+    return r;
+}
+
+#define U32X4_MAP2(name, expr)                                         \
+    static inline u32x4 name(u32x4 a, u32x4 b) {                       \
+        u32x4 r;                                                       \
+        for (int i = 0; i < 4; i++) r.v[i] = (expr);                   \
+        return r;                                                      \
+    }
+
+static inline u32x4 u32x4_set1(u32 s) {
+    u32x4 r = {{ s, s, s, s }};
+    return r;
+}
+U32X4_MAP2(u32x4_add, a.v[i] + b.v[i])
+U32X4_MAP2(u32x4_and, a.v[i] & b.v[i])
+U32X4_MAP2(u32x4_or,  a.v[i] | b.v[i])
+U32X4_MAP2(u32x4_xor, a.v[i] ^ b.v[i])
+U32X4_MAP2(u32x4_mul, a.v[i] * b.v[i])
+U32X4_MAP2(u32x4_eq,  a.v[i] == b.v[i] ? 0xFFFFFFFFu : 0u)
+static inline u32x4 u32x4_shl(u32x4 a, int n) {
+    u32x4 r;
+    for (int i = 0; i < 4; i++) r.v[i] = a.v[i] << n;
+    return r;
+}
+static inline u32x4 u32x4_shr(u32x4 a, int n) {
+    u32x4 r;
+    for (int i = 0; i < 4; i++) r.v[i] = a.v[i] >> n;
+    return r;
+}
+static inline u32x4 u32x4_from_f32(f32x4 a) {
+    u32x4 r;
+    for (int i = 0; i < 4; i++) r.v[i] = (u32)(s32)a.v[i];
+    return r;
+}
+
+#undef F32X4_MAP2
+#undef U32X4_MAP2
+
+#endif
+
+// a * b + c (not fused; results match the scalar path bit-for-bit per op)
+static inline f32x4 f32x4_madd(f32x4 a, f32x4 b, f32x4 c) {
+    return f32x4_add(f32x4_mul(a, b), c);
+}
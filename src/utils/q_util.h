@@ -29,3 +29,32 @@ typedef double f64;
 /* ---- Bit helpers ---- */
 #define BIT(n) (1u << (n))
 #define HAS_BIT(x, n) (((x) & BIT(n)) != 0)
+
+/* ---- Hashing ---- */
+// 64-bit FNV-1a. Chain by passing the previous result as `h`; start from
+// FNV1A64_SEED. Used for content hashes, cache keys and replay checksums,
+// so the output must never change.
+#define FNV1A64_SEED 0xcbf29ce484222325ull
+
+static inline u64 fnv1a64(u64 h, const void *data, size_t size) {
+    const u8 *p = (const u8 *)data;
+    for (size_t i = 0; i < size; i++) {
+        h ^= p[i];
+        h *= 0x100000001b3ull;
+    }
+    return h;
+}
+
+// A value's four bytes, least significant first on every platform
+static inline u64 fnv1a64_u32(u64 h, u32 v) {
+    for (int i = 0; i < 4; i++) {
+        h ^= (v >> (i * 8)) & 0xFF;
+        h *= 0x100000001b3ull;
+    }
+    return h;
+}
+
+static inline u64 fnv1a64_f32(u64 h, f32 v) {
+    union { f32 f; u32 u; } bits = { v };
+    return fnv1a64_u32(h, bits.u);
+}